@@ -26,6 +26,7 @@
 #include <sys/stat.h>
 #include <string.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <getopt.h>
 #include "flash.h"
 #include "flashchips.h"
@@ -41,8 +42,10 @@ static void cli_classic_usage(const char *name)
 	       "-z|"
 #endif
 	       "-p <programmername>[:<parameters>] [-c <chipname>]\n"
-	       "[-E|(-r|-w|-v) <file>] [-l <layoutfile> [-i <imagename>]...] [-n] [-f]]\n"
-	       "[-V[V[V]]] [-o <logfile>]\n\n", name);
+	       "[-E|(-r|-w|-v) <file>] [-l <layoutfile> [-i <imagename>]...] [-n|--verify-all] [-f]]\n"
+	       "[-V[V[V]]] [-o <logfile>] [--stream <size>] [--probe-cache <file>]\n"
+	       "[--batch <file>|--daemon <socket>] [--shadow] [--metrics <file>]\n"
+	       "[--progress]\n\n", name);
 
 	printf(" -h | --help                        print this help text\n"
 	       " -R | --version                     print version (release)\n"
@@ -54,9 +57,24 @@ static void cli_classic_usage(const char *name)
 	       " -c | --chip <chipname>             probe only for specified flash chip\n"
 	       " -f | --force                       force specific operations (see man page)\n"
 	       " -n | --noverify                    don't auto-verify\n"
+	       "      --verify-all                  auto-verify the whole chip, not only the\n"
+	       "                                    erase blocks touched by the write\n"
 	       " -l | --layout <layoutfile>         read ROM layout from <layoutfile>\n"
 	       " -i | --image <name>                only flash image <name> from flash layout\n"
 	       " -o | --output <logfile>            log output to <logfile>\n"
+	       "      --stream <size>               write in windows of <size> kB to bound\n"
+	       "                                    memory use\n"
+	       "      --probe-cache <file>          remember the chip found with this programmer\n"
+	       "                                    in <file> and probe for it first next time\n"
+	       "      --batch <file>                perform the operations listed in <file>\n"
+	       "      --daemon <socket>             keep the programmer and chip set up and serve\n"
+	       "                                    requests on the UNIX socket <socket>\n"
+	       "      --shadow                      reuse chip contents read or written earlier in\n"
+	       "                                    a batch or daemon session\n"
+	       "      --metrics <file>              write timing and transfer statistics of the\n"
+	       "                                    run to <file> as JSON, - for stdout\n"
+	       "      --progress                    show progress, throughput and remaining time\n"
+	       "                                    of long operations\n"
 	       " -L | --list-supported              print supported devices\n"
 #if CONFIG_PRINT_WIKI == 1
 	       " -z | --list-supported-wiki         print supported devices in wiki syntax\n"
@@ -89,6 +107,195 @@ static int check_filename(char *filename, char *type)
 	return 0;
 }
 
+/* The probe cache file has one line per programmer, the programmer name and parameters as given on the command
+ * line, a tab and the name of the chip that was found with it.
+ */
+#define PROBE_CACHE_LINE_MAX	1024
+
+/* Reads the next line of the probe cache file into @line, without the newline. Lines which don't fit into
+ * @line or lack the newline (cut off) are skipped. Returns 0 at the end of the file.
+ */
+static int probe_cache_file_getline(FILE *f, char *line, int size)
+{
+	size_t len;
+	int c;
+
+	while (fgets(line, size, f)) {
+		len = strlen(line);
+		if (line[len - 1] == '\n') {
+			line[len - 1] = '\0';
+			return 1;
+		}
+		while ((c = getc(f)) != EOF && c != '\n')
+			;
+	}
+	return 0;
+}
+
+/* Returns the cached chip name for @key, or NULL. The caller has to free it. */
+static char *probe_cache_file_lookup(const char *filename, const char *key)
+{
+	char line[PROBE_CACHE_LINE_MAX];
+	size_t keylen = strlen(key);
+	char *name = NULL;
+	FILE *f;
+
+	f = fopen(filename, "r");
+	if (!f)
+		return NULL;
+	while (probe_cache_file_getline(f, line, sizeof(line))) {
+		if (!strncmp(line, key, keylen) && line[keylen] == '\t') {
+			name = strdup(line + keylen + 1);
+			break;
+		}
+	}
+	fclose(f);
+	return name;
+}
+
+/* Returns the contents of the probe cache file without the entry for @key, NULL if there are none. */
+static char *probe_cache_file_others(const char *filename, const char *key)
+{
+	char line[PROBE_CACHE_LINE_MAX];
+	size_t keylen = strlen(key);
+	char *contents = NULL;
+	size_t len = 0;
+	FILE *f;
+
+	f = fopen(filename, "r");
+	if (!f)
+		return NULL;
+	while (probe_cache_file_getline(f, line, sizeof(line))) {
+		char *tmp;
+		if (!strncmp(line, key, keylen) && line[keylen] == '\t')
+			continue;
+		tmp = realloc(contents, len + strlen(line) + 2);
+		if (!tmp) {
+			msg_gerr("Out of memory!\n");
+			exit(1);
+		}
+		contents = tmp;
+		len += sprintf(contents + len, "%s\n", line);
+	}
+	fclose(f);
+	return contents;
+}
+
+#if defined(_WIN32) || defined(__DJGPP__) || defined(__LIBPAYLOAD__)
+
+/* Replaces or adds the entry for @key. Failing to update the cache is not an error. */
+static void probe_cache_file_store(const char *filename, const char *key, const char *name)
+{
+	char *contents;
+	FILE *f;
+
+	if (strlen(key) + strlen(name) + 2 >= PROBE_CACHE_LINE_MAX) {
+		msg_gdbg("Not caching the chip, the programmer parameters are too long.\n");
+		return;
+	}
+	contents = probe_cache_file_others(filename, key);
+	f = fopen(filename, "w");
+	if (!f) {
+		msg_gwarn("Warning: Could not update probe cache file %s.\n", filename);
+		free(contents);
+		return;
+	}
+	if (contents)
+		fputs(contents, f);
+	fprintf(f, "%s\t%s\n", key, name);
+	if (fclose(f))
+		msg_gwarn("Warning: Could not update probe cache file %s.\n", filename);
+	free(contents);
+}
+
+#else
+
+#include <unistd.h>
+#include <sys/file.h>
+
+/* Replaces or adds the entry for @key. Failing to update the cache is not an error.
+ * Several flashrom runs may share the cache file. Updates are serialized with a lock on <file>.lock, and the
+ * new contents go to a temporary file which replaces the cache, so neither concurrent runs nor a crash can
+ * leave it truncated.
+ */
+static void probe_cache_file_store(const char *filename, const char *key, const char *name)
+{
+	char *contents = NULL, *lockname, *tmpname;
+	int lockfd, fd, ret = 1;
+	mode_t mask;
+	FILE *f;
+
+	if (strlen(key) + strlen(name) + 2 >= PROBE_CACHE_LINE_MAX) {
+		msg_gdbg("Not caching the chip, the programmer parameters are too long.\n");
+		return;
+	}
+	lockname = malloc(strlen(filename) + sizeof(".lock"));
+	tmpname = malloc(strlen(filename) + sizeof(".XXXXXX"));
+	if (!lockname || !tmpname) {
+		msg_gerr("Out of memory!\n");
+		exit(1);
+	}
+	sprintf(lockname, "%s.lock", filename);
+	sprintf(tmpname, "%s.XXXXXX", filename);
+
+	lockfd = open(lockname, O_RDWR | O_CREAT, 0666);
+	if (lockfd < 0 || flock(lockfd, LOCK_EX))
+		goto out;
+	contents = probe_cache_file_others(filename, key);
+	fd = mkstemp(tmpname);
+	if (fd < 0)
+		goto out;
+	/* mkstemp() creates the file for the owner only, give it the permissions a new cache file would get. */
+	mask = umask(0);
+	umask(mask);
+	fchmod(fd, 0666 & ~mask);
+	f = fdopen(fd, "w");
+	if (!f) {
+		close(fd);
+		unlink(tmpname);
+		goto out;
+	}
+	if (contents)
+		fputs(contents, f);
+	fprintf(f, "%s\t%s\n", key, name);
+	ret = fflush(f) || fsync(fd);
+	if (fclose(f))
+		ret = 1;
+	if (!ret)
+		ret = rename(tmpname, filename);
+	if (ret)
+		unlink(tmpname);
+out:
+	if (ret)
+		msg_gwarn("Warning: Could not update probe cache file %s.\n", filename);
+	/* Closing the lock file releases the lock. */
+	if (lockfd >= 0)
+		close(lockfd);
+	free(contents);
+	free(lockname);
+	free(tmpname);
+}
+
+#endif
+
+/* Probes all registered programmers for up to @max chips, returns the number of chips found. */
+static int probe_programmers(struct flashctx *flashes, int max)
+{
+	int j, startchip, chipcount = 0;
+
+	for (j = 0; j < registered_programmer_count; j++) {
+		startchip = 0;
+		while (chipcount < max) {
+			startchip = probe_flash(&registered_programmers[j], startchip, &flashes[chipcount], 0);
+			if (startchip == -1)
+				break;
+			chipcount++;
+			startchip++;
+		}
+	}
+	return chipcount;
+}
+
 int main(int argc, char *argv[])
 {
 	unsigned long size;
@@ -105,8 +312,20 @@ int main(int argc, char *argv[])
 	int read_it = 0, write_it = 0, erase_it = 0, verify_it = 0;
 	int dont_verify_it = 0, list_supported = 0, operation_specified = 0;
 	enum programmer prog = PROGRAMMER_INVALID;
+	unsigned long stream_kb = 0;
 	int ret = 0;
 
+	/* Values for options without a short equivalent, outside the range of characters. */
+	enum {
+		OPTION_VERIFY_ALL = 0x0100,
+		OPTION_STREAM,
+		OPTION_PROBE_CACHE,
+		OPTION_DAEMON,
+		OPTION_BATCH,
+		OPTION_SHADOW,
+		OPTION_METRICS,
+		OPTION_PROGRESS,
+	};
 	static const char optstring[] = "r:Rw:v:nVEfc:l:i:p:Lzho:";
 	static const struct option long_options[] = {
 		{"read",		1, NULL, 'r'},
@@ -125,6 +344,14 @@ int main(int argc, char *argv[])
 		{"help",		0, NULL, 'h'},
 		{"version",		0, NULL, 'R'},
 		{"output",		1, NULL, 'o'},
+		{"verify-all",		0, NULL, OPTION_VERIFY_ALL},
+		{"stream",		1, NULL, OPTION_STREAM},
+		{"probe-cache",		1, NULL, OPTION_PROBE_CACHE},
+		{"daemon",		1, NULL, OPTION_DAEMON},
+		{"batch",		1, NULL, OPTION_BATCH},
+		{"shadow",		0, NULL, OPTION_SHADOW},
+		{"metrics",		1, NULL, OPTION_METRICS},
+		{"progress",		0, NULL, OPTION_PROGRESS},
 		{NULL,			0, NULL, 0},
 	};
 
@@ -135,6 +362,12 @@ int main(int argc, char *argv[])
 #endif /* !STANDALONE */
 	char *tempstr = NULL;
 	char *pparam = NULL;
+	char *probe_cache_file = NULL;
+	char *daemon_socket = NULL;
+	char *batch_file = NULL;
+	char *metrics_file = NULL;
+	char *probe_cache_key = NULL;
+	char *cached_chip = NULL;
 
 	print_version();
 	print_banner();
@@ -188,6 +421,35 @@ int main(int argc, char *argv[])
 			}
 			dont_verify_it = 1;
 			break;
+		case OPTION_VERIFY_ALL:
+			verify_all = 1;
+			break;
+		case OPTION_STREAM:
+			stream_kb = strtoul(optarg, &tempstr, 0);
+			if (!stream_kb || *tempstr != '\0' || stream_kb > UINT_MAX / 1024) {
+				fprintf(stderr, "Invalid window size \"%s\" for --stream.\n", optarg);
+				cli_classic_abort_usage();
+			}
+			stream_size = stream_kb * 1024;
+			break;
+		case OPTION_PROBE_CACHE:
+			probe_cache_file = strdup(optarg);
+			break;
+		case OPTION_DAEMON:
+			daemon_socket = strdup(optarg);
+			break;
+		case OPTION_BATCH:
+			batch_file = strdup(optarg);
+			break;
+		case OPTION_SHADOW:
+			use_shadow = 1;
+			break;
+		case OPTION_METRICS:
+			metrics_file = strdup(optarg);
+			break;
+		case OPTION_PROGRESS:
+			show_progress = 1;
+			break;
 		case 'c':
 			chip_to_probe = strdup(optarg);
 			break;
@@ -327,6 +589,31 @@ int main(int argc, char *argv[])
 		cli_classic_abort_usage();
 	}
 
+	if (stream_size && !write_it && !batch_file && !daemon_socket) {
+		fprintf(stderr, "Error: --stream can only be used with --write, --batch or --daemon.\n");
+		cli_classic_abort_usage();
+	}
+
+	if (daemon_socket && (operation_specified || batch_file)) {
+		fprintf(stderr, "Error: --daemon takes its operations from the socket.\n");
+		cli_classic_abort_usage();
+	}
+	if (batch_file && operation_specified) {
+		fprintf(stderr, "Error: --batch takes its operations from the batch file.\n");
+		cli_classic_abort_usage();
+	}
+	if (batch_file && check_filename(batch_file, "batch")) {
+		cli_classic_abort_usage();
+	}
+	if (daemon_socket && check_filename(daemon_socket, "socket")) {
+		cli_classic_abort_usage();
+	}
+	if (probe_cache_file && check_filename(probe_cache_file, "probe cache")) {
+		cli_classic_abort_usage();
+	}
+	if (metrics_file && strcmp(metrics_file, "-") && check_filename(metrics_file, "metrics")) {
+		cli_classic_abort_usage();
+	}
 	if ((read_it | write_it | verify_it) && check_filename(filename, "image")) {
 		cli_classic_abort_usage();
 	}
@@ -342,6 +629,8 @@ int main(int argc, char *argv[])
 	free(logfile);
 #endif /* !STANDALONE */
 
+	metrics_start();
+
 #if CONFIG_PRINT_WIKI == 1
 	if (list_supported_wiki) {
 		print_supported_wiki();
@@ -370,7 +659,7 @@ int main(int argc, char *argv[])
 		ret = 1;
 		goto out;
 	}
-	if (layoutfile != NULL && !write_it) {
+	if (layoutfile != NULL && !write_it && !batch_file && !daemon_socket) {
 		msg_gerr("Layout files are currently supported for write operations only.\n");
 		ret = 1;
 		goto out;
@@ -380,12 +669,16 @@ int main(int argc, char *argv[])
 		ret = 1;
 		goto out;
 	}
+	if ((batch_file || daemon_socket) && layout_has_included_regions()) {
+		msg_gerr("Regions are selected per operation in batch and daemon mode, not with -i.\n");
+		ret = 1;
+		goto out;
+	}
 	/* Does a chip with the requested name exist in the flashchips array? */
 	if (chip_to_probe) {
-		for (chip = flashchips; chip && chip->name; chip++)
-			if (!strcmp(chip->name, chip_to_probe))
-				break;
-		if (!chip || !chip->name) {
+		i = find_flashchip_name(chip_to_probe);
+		chip = (i < 0) ? NULL : &flashchips[flashchips_name_index[i]];
+		if (!chip) {
 			msg_cerr("Error: Unknown chip '%s' specified.\n", chip_to_probe);
 			msg_gerr("Run flashrom -L to view the hardware supported in this flashrom version.\n");
 			ret = 1;
@@ -416,6 +709,16 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	/* Programmer initialization consumes the parameters, so build the cache key first. */
+	if (probe_cache_file) {
+		probe_cache_key = malloc(strlen(programmer_table[prog].name) + 1 + (pparam ? strlen(pparam) : 0) + 1);
+		if (!probe_cache_key) {
+			msg_gerr("Out of memory!\n");
+			exit(1);
+		}
+		sprintf(probe_cache_key, "%s:%s", programmer_table[prog].name, pparam ? pparam : "");
+	}
+
 	/* FIXME: Delay calibration should happen in programmer code. */
 	myusec_calibrate_delay();
 
@@ -428,16 +731,31 @@ int main(int argc, char *argv[])
 	msg_pdbg("The following protocols are supported: %s.\n", tempstr);
 	free(tempstr);
 
-	for (j = 0; j < registered_programmer_count; j++) {
-		startchip = 0;
-		while (chipcount < ARRAY_SIZE(flashes)) {
-			startchip = probe_flash(&registered_programmers[j], startchip, &flashes[chipcount], 0);
-			if (startchip == -1)
-				break;
-			chipcount++;
-			startchip++;
+	/* Try the chip found last time first. Only a single, unambiguous match is trusted, anything else gets a
+	 * full probe.
+	 */
+	if (probe_cache_key && !chip_to_probe) {
+		cached_chip = probe_cache_file_lookup(probe_cache_file, probe_cache_key);
+		if (cached_chip && find_flashchip_name(cached_chip) >= 0) {
+			msg_cdbg("Probing for cached chip \"%s\" first.\n", cached_chip);
+			chip_to_probe = cached_chip;
+			chipcount = probe_programmers(flashes, ARRAY_SIZE(flashes));
+			chip_to_probe = NULL;
+			if (chipcount != 1) {
+				for (i = 0; i < chipcount; i++) {
+					free(flashes[i].chip);
+					flashes[i].chip = NULL;
+				}
+				chipcount = 0;
+				msg_cdbg("Cached chip not confirmed, probing for all chips.\n");
+			}
 		}
 	}
+	if (!chipcount)
+		chipcount = probe_programmers(flashes, ARRAY_SIZE(flashes));
+	if (probe_cache_key && chipcount == 1 && !chip_to_probe &&
+	    (!cached_chip || strcmp(cached_chip, flashes[0].chip->name)))
+		probe_cache_file_store(probe_cache_file, probe_cache_key, flashes[0].chip->name);
 
 	if (chipcount > 1) {
 		msg_cinfo("Multiple flash chip definitions match the detected chip(s): \"%s\"",
@@ -510,7 +828,7 @@ int main(int argc, char *argv[])
 		goto out_shutdown;
 	}
 
-	if (!(read_it | write_it | verify_it | erase_it)) {
+	if (!(read_it | write_it | verify_it | erase_it) && !batch_file && !daemon_socket) {
 		msg_ginfo("No operations were specified.\n");
 		goto out_shutdown;
 	}
@@ -524,6 +842,14 @@ int main(int argc, char *argv[])
 	 * Give the chip time to settle.
 	 */
 	programmer_delay(100000);
+	if (batch_file) {
+		ret = run_batch(fill_flash, force, !dont_verify_it, batch_file);
+		goto out_shutdown;
+	}
+	if (daemon_socket) {
+		ret = serve_daemon(fill_flash, force, !dont_verify_it, daemon_socket);
+		goto out_shutdown;
+	}
 	ret |= doit(fill_flash, force, filename, read_it, write_it, erase_it, verify_it);
 	/* Note: doit() already calls programmer_shutdown(). */
 	goto out;
@@ -531,13 +857,25 @@ int main(int argc, char *argv[])
 out_shutdown:
 	programmer_shutdown();
 out:
-	for (i = 0; i < chipcount; i++)
+	if (metrics_file)
+		ret |= metrics_write_json(metrics_file,
+					  prog != PROGRAMMER_INVALID ? programmer_table[prog].name : NULL,
+					  chipcount == 1 ? flashes[0].chip->name : NULL);
+	for (i = 0; i < chipcount; i++) {
+		free_shadow(&flashes[i]);
 		free(flashes[i].chip);
+	}
 
 	layout_cleanup();
 	free(filename);
 	free(layoutfile);
 	free(pparam);
+	free(probe_cache_file);
+	free(daemon_socket);
+	free(batch_file);
+	free(metrics_file);
+	free(probe_cache_key);
+	free(cached_chip);
 	/* clean up global variables */
 	free((char *)chip_to_probe); /* Silence! Freeing is not modifying contents. */
 	chip_to_probe = NULL;
@@ -0,0 +1,285 @@
+/*
+ * This file is part of the flashrom project.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/*
+ * Batch and daemon mode: Keep the programmer initialized and the chip probed for a series of operations on
+ * the same board, so that each of them doesn't pay for the setup again.
+ *
+ * Both take requests of the form
+ *	read <file> | write <file> [<region>...] | verify <file> | erase | quit
+ * where the regions refer to the layout file given with -l, and write the whole image if there are none.
+ * The batch mode reads them line by line from a file and stops at the first failing one. The daemon mode
+ * serves them on a UNIX socket: Each connection carries a single request line, sent in one write. Instead of
+ * a file name, the client can pass one open file descriptor with the request (SCM_RIGHTS), e.g. of a memfd,
+ * and omit the name. The daemon answers with "OK" or "FAILED" and closes the connection. The socket is only
+ * accessible to the user running the daemon, and the daemon refuses to replace one that another daemon is
+ * still listening on.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "flash.h"
+
+#define REQUEST_MAX	4096
+
+/* Performs the request in @request, with the file name replaced by the descriptor @fd if that is not -1.
+ * Returns 0 on success, 1 on failure and -1 if the session should end.
+ */
+static int handle_request(struct flashctx *flash, int force, int verify_it, char *request, int fd)
+{
+	char fdpath[32];
+	char *op, *filename = NULL, *region;
+	int read_it = 0, write_it = 0, erase_it = 0;
+
+	op = strtok(request, " \t");
+	if (!op)
+		return 0;
+	msg_ginfo("Request: %s\n", op);
+	if (!strcmp(op, "quit"))
+		return -1;
+	if (!strcmp(op, "read"))
+		read_it = 1;
+	else if (!strcmp(op, "write"))
+		write_it = 1;
+	else if (!strcmp(op, "verify"))
+		verify_it = 1;
+	else if (!strcmp(op, "erase"))
+		erase_it = 1;
+	else {
+		msg_gerr("Unknown request \"%s\".\n", op);
+		return 1;
+	}
+	if (read_it || erase_it)
+		verify_it = 0;
+
+	if (!erase_it) {
+		if (fd >= 0) {
+			/* Reopening the passed descriptor lets the file based operations use it unchanged. */
+			snprintf(fdpath, sizeof(fdpath), "/dev/fd/%i", fd);
+			filename = fdpath;
+		} else {
+			filename = strtok(NULL, " \t");
+		}
+		if (!filename) {
+			msg_gerr("Request \"%s\" needs a file.\n", op);
+			return 1;
+		}
+	}
+
+	/* Regions are selected per request. */
+	layout_clear_includes();
+	while ((region = strtok(NULL, " \t"))) {
+		if (!write_it) {
+			msg_gerr("Regions can only be selected for write requests.\n");
+			return 1;
+		}
+		region = strdup(region);
+		if (!region) {
+			msg_gerr("Out of memory!\n");
+			exit(1);
+		}
+		if (register_include_arg(region))
+			return 1;
+	}
+	if (process_include_args())
+		return 1;
+
+	return doit_noshutdown(flash, force, filename, read_it, write_it, erase_it, verify_it) ? 1 : 0;
+}
+
+int run_batch(struct flashctx *flash, int force, int verify_it, const char *path)
+{
+	char request[REQUEST_MAX];
+	int lineno = 0, ret = 0;
+	FILE *batch;
+
+	batch = fopen(path, "r");
+	if (!batch) {
+		msg_gerr("Error: opening batch file \"%s\" failed: %s\n", path, strerror(errno));
+		return 1;
+	}
+	while (fgets(request, sizeof(request), batch)) {
+		lineno++;
+		request[strcspn(request, "\r\n")] = '\0';
+		if (request[0] == '#')
+			continue;
+		ret = handle_request(flash, force, verify_it, request, -1);
+		if (ret > 0)
+			msg_gerr("Batch file \"%s\" line %i failed, stopping.\n", path, lineno);
+		if (ret)
+			break;
+	}
+	fclose(batch);
+	layout_clear_includes();
+	return ret > 0 ? 1 : 0;
+}
+
+#if defined(_WIN32) || defined(__DJGPP__) || defined(__LIBPAYLOAD__)
+
+int serve_daemon(struct flashctx *flash, int force, int verify_it, const char *path)
+{
+	msg_gerr("Daemon mode is not supported on this platform.\n");
+	return 1;
+}
+
+#else
+
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+
+/* The number of file descriptors a request can carry. Only one is allowed, room for more lets us notice and
+ * close them.
+ */
+#define REQUEST_FDS_MAX	8
+
+/* Receives a request line and the file descriptor optionally passed along with it (-1 if none). Returns 0 on
+ * success, -1 if nothing was received and 1 if the request carried more than one descriptor. Such requests
+ * are rejected and all of their descriptors closed.
+ */
+static int receive_request(int conn, char *buf, size_t size, int *fd)
+{
+	union {
+		struct cmsghdr hdr;
+		char buf[CMSG_SPACE(REQUEST_FDS_MAX * sizeof(int))];
+	} control;
+	struct iovec iov = { .iov_base = buf, .iov_len = size - 1 };
+	struct msghdr msg = {
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+		.msg_control = control.buf,
+		.msg_controllen = sizeof(control.buf),
+	};
+	struct cmsghdr *cmsg;
+	ssize_t len;
+	int i, n, fds[REQUEST_FDS_MAX], nfds = 0;
+
+	*fd = -1;
+	len = recvmsg(conn, &msg, 0);
+	if (len <= 0)
+		return -1;
+	buf[len] = '\0';
+	buf[strcspn(buf, "\r\n")] = '\0';
+	for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+			continue;
+		n = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+		for (i = 0; i < n && nfds < REQUEST_FDS_MAX; i++)
+			memcpy(&fds[nfds++], CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+	}
+	if (nfds > 1 || (msg.msg_flags & MSG_CTRUNC)) {
+		msg_gerr("Rejecting a request with more than one file descriptor.\n");
+		for (i = 0; i < nfds; i++)
+			close(fds[i]);
+		return 1;
+	}
+	if (nfds)
+		*fd = fds[0];
+	return 0;
+}
+
+int serve_daemon(struct flashctx *flash, int force, int verify_it, const char *path)
+{
+	struct sockaddr_un addr = { .sun_family = AF_UNIX };
+	char request[REQUEST_MAX];
+	struct stat st;
+	mode_t old_umask;
+	int sock, conn, fd, res;
+	const char *reply;
+
+	if (strlen(path) >= sizeof(addr.sun_path)) {
+		msg_gerr("Socket path %s is too long.\n", path);
+		return 1;
+	}
+	strcpy(addr.sun_path, path);
+
+	sock = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (sock < 0) {
+		msg_gerr("Can't create a socket: %s\n", strerror(errno));
+		return 1;
+	}
+	/* A stale socket left behind by an earlier daemon would make bind() fail, anything else stays. One that
+	 * still accepts connections belongs to a running daemon, which must keep it.
+	 */
+	if (!lstat(path, &st) && S_ISSOCK(st.st_mode)) {
+		if (!connect(sock, (struct sockaddr *)&addr, sizeof(addr))) {
+			msg_gerr("Another daemon is already listening on %s.\n", path);
+			close(sock);
+			return 1;
+		}
+		close(sock);
+		unlink(path);
+		sock = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (sock < 0) {
+			msg_gerr("Can't create a socket: %s\n", strerror(errno));
+			return 1;
+		}
+	}
+	/* Only our own user may connect: Requests can overwrite the chip. */
+	old_umask = umask(0077);
+	res = bind(sock, (struct sockaddr *)&addr, sizeof(addr));
+	umask(old_umask);
+	if (res || listen(sock, 4)) {
+		msg_gerr("Can't listen on %s: %s\n", path, strerror(errno));
+		close(sock);
+		return 1;
+	}
+	/* A client going away before reading its reply must not kill the daemon. */
+	signal(SIGPIPE, SIG_IGN);
+
+	msg_ginfo("Waiting for requests on %s.\n", path);
+	while (1) {
+		conn = accept(sock, NULL, NULL);
+		if (conn < 0) {
+			if (errno == EINTR)
+				continue;
+			msg_gerr("Accepting a connection failed: %s\n", strerror(errno));
+			res = 1;
+			break;
+		}
+		res = receive_request(conn, request, sizeof(request), &fd);
+		if (res < 0) {
+			close(conn);
+			continue;
+		}
+		if (!res)
+			res = handle_request(flash, force, verify_it, request, fd);
+		layout_clear_includes();
+		if (fd >= 0)
+			close(fd);
+		reply = (res > 0) ? "FAILED\n" : "OK\n";
+		if (write(conn, reply, strlen(reply)) < 0)
+			msg_gdbg("Could not send the reply: %s\n", strerror(errno));
+		close(conn);
+		if (res < 0) {
+			res = 0;
+			break;
+		}
+	}
+	close(sock);
+	unlink(path);
+	return res;
+}
+
+#endif
@@ -22,16 +22,17 @@
 #include <stdio.h>
 #include <ctype.h>
 #include <errno.h>
+#include <limits.h>
 #include "flash.h"
 #include "chipdrivers.h"
 #include "programmer.h"
+#include "spi.h"
 
 /* Remove the #define below if you don't want SPI flash chip emulation. */
 #define EMULATE_SPI_CHIP 1
 
 #if EMULATE_SPI_CHIP
 #define EMULATE_CHIP 1
-#include "spi.h"
 #endif
 
 #if EMULATE_CHIP
@@ -65,6 +66,16 @@ int spi_blacklist_size = 0;
 int spi_ignorelist_size = 0;
 static uint8_t emu_status = 0;
 
+/* Timing model: Programs and erases keep WIP set for the configured number of microseconds (0 completes them
+ * instantly).
+ */
+static uint64_t emu_busy_until = 0;
+static unsigned int emu_time_program = 0;
+static unsigned int emu_time_erase_4k = 0;
+static unsigned int emu_time_erase_32k = 0;
+static unsigned int emu_time_erase_64k = 0;
+static unsigned int emu_time_erase_chip = 0;
+
 /* A legit complete SFDP table based on the MX25L6436E (rev. 1.8) datasheet. */
 static const uint8_t sfdp_table[] = {
 	0x53, 0x46, 0x44, 0x50, // @0x00: SFDP signature
@@ -96,6 +107,26 @@ static const uint8_t sfdp_table[] = {
 
 static unsigned int spi_write_256_chunksize = 256;
 
+/* The clock of the timing model and the transport emulation is either the real one, or a virtual one which
+ * only advances by the emulated durations and in programmer_delay(), which then returns immediately.
+ */
+enum emu_clock {
+	EMU_CLOCK_NONE,
+	EMU_CLOCK_VIRTUAL,
+	EMU_CLOCK_REAL,
+};
+static enum emu_clock emu_clock = EMU_CLOCK_NONE;
+static uint64_t emu_virtual_us = 0;
+
+/* Transport emulation: Each SPI transaction costs the latency plus its bytes at the given bandwidth (0 for
+ * unlimited), and may carry at most the given number of data bytes (0 for unlimited).
+ */
+static unsigned int spi_latency = 0;
+static unsigned int spi_bandwidth = 0;
+static unsigned int spi_max_read = 0;
+static unsigned int spi_max_write = 0;
+static uint64_t spi_transfer_ns = 0;
+
 static int dummy_spi_send_command(struct flashctx *flash, unsigned int writecnt,
 				  unsigned int readcnt,
 				  const unsigned char *writearr,
@@ -119,7 +150,7 @@ static uint32_t dummy_chip_readl(const struct flashctx *flash,
 static void dummy_chip_readn(const struct flashctx *flash, uint8_t *buf,
 			     const chipaddr addr, size_t len);
 
-static const struct spi_programmer spi_programmer_dummyflasher = {
+static struct spi_programmer spi_programmer_dummyflasher = {
 	.type		= SPI_CONTROLLER_DUMMY,
 	.max_data_read	= MAX_DATA_READ_UNLIMITED,
 	.max_data_write	= MAX_DATA_UNSPECIFIED,
@@ -157,9 +188,163 @@ static int dummy_shutdown(void *data)
 		free(flashchip_contents);
 	}
 #endif
+	if (emu_clock == EMU_CLOCK_VIRTUAL)
+		msg_pinfo("Emulated time: %llu us, %llu us of it in SPI transfers\n",
+			  (unsigned long long)emu_virtual_us, (unsigned long long)(spi_transfer_ns / 1000));
+	return 0;
+}
+
+static uint64_t emu_now(void)
+{
+	return (emu_clock == EMU_CLOCK_VIRTUAL) ? emu_virtual_us : metrics_time_us();
+}
+
+/* Parses the unsigned value of parameter @name into @val if it is given. Returns 1 on error. */
+static int get_uint_param(const char *name, unsigned int *val)
+{
+	char *tmp, *endptr;
+	unsigned long res;
+
+	tmp = extract_programmer_param(name);
+	if (!tmp)
+		return 0;
+	errno = 0;
+	res = strtoul(tmp, &endptr, 0);
+	if (errno || tmp == endptr || *endptr != '\0' || res > UINT_MAX) {
+		msg_perr("Error: Invalid value \"%s\" for %s.\n", tmp, name);
+		free(tmp);
+		return 1;
+	}
+	free(tmp);
+	*val = res;
+	return 0;
+}
+
+static int init_transport(void)
+{
+	char *tmp;
+
+	/* Start from scratch, nothing may carry over from a previous programmer_init(). */
+	emu_clock = EMU_CLOCK_NONE;
+	emu_virtual_us = 0;
+	spi_latency = 0;
+	spi_bandwidth = 0;
+	spi_max_read = 0;
+	spi_max_write = 0;
+	spi_transfer_ns = 0;
+	spi_programmer_dummyflasher.max_data_read = MAX_DATA_READ_UNLIMITED;
+	spi_programmer_dummyflasher.max_data_write = MAX_DATA_UNSPECIFIED;
+#if EMULATE_SPI_CHIP
+	emu_busy_until = 0;
+	emu_status &= ~SPI_SR_WIP;
+	emu_time_program = 0;
+	emu_time_erase_4k = 0;
+	emu_time_erase_32k = 0;
+	emu_time_erase_64k = 0;
+	emu_time_erase_chip = 0;
+#endif
+
+	tmp = extract_programmer_param("clock");
+	if (tmp) {
+		if (!strcmp(tmp, "virtual")) {
+			emu_clock = EMU_CLOCK_VIRTUAL;
+		} else if (!strcmp(tmp, "real")) {
+			emu_clock = EMU_CLOCK_REAL;
+		} else {
+			msg_perr("Error: Invalid clock \"%s\", use virtual or real.\n", tmp);
+			free(tmp);
+			return 1;
+		}
+		free(tmp);
+	}
+	if (get_uint_param("spi_latency", &spi_latency) ||
+	    get_uint_param("spi_bandwidth", &spi_bandwidth) ||
+	    get_uint_param("spi_max_read", &spi_max_read) ||
+	    get_uint_param("spi_max_write", &spi_max_write))
+		return 1;
+#if EMULATE_SPI_CHIP
+	if (get_uint_param("time_program", &emu_time_program) ||
+	    get_uint_param("time_erase_4k", &emu_time_erase_4k) ||
+	    get_uint_param("time_erase_32k", &emu_time_erase_32k) ||
+	    get_uint_param("time_erase_64k", &emu_time_erase_64k) ||
+	    get_uint_param("time_erase_chip", &emu_time_erase_chip))
+		return 1;
+	/* Durations make sense with the virtual clock unless told otherwise. */
+	if (emu_clock == EMU_CLOCK_NONE && (emu_time_program || emu_time_erase_4k || emu_time_erase_32k ||
+					     emu_time_erase_64k || emu_time_erase_chip))
+		emu_clock = EMU_CLOCK_VIRTUAL;
+	if (emu_clock != EMU_CLOCK_NONE)
+		msg_pdbg("Chip timing: program %u us, erase 4k %u us, 32k %u us, 64k %u us, chip %u us\n",
+			 emu_time_program, emu_time_erase_4k, emu_time_erase_32k, emu_time_erase_64k,
+			 emu_time_erase_chip);
+#endif
+	if (emu_clock == EMU_CLOCK_NONE && (spi_latency || spi_bandwidth))
+		emu_clock = EMU_CLOCK_VIRTUAL;
+	if (emu_clock != EMU_CLOCK_NONE)
+		msg_pdbg("SPI transport on %s clock: latency %u us, bandwidth %u B/s\n",
+			 emu_clock == EMU_CLOCK_VIRTUAL ? "virtual" : "real", spi_latency, spi_bandwidth);
+	/* Chunked reads and writes have to fit into the transfer size limits. */
+	if (spi_max_read)
+		spi_programmer_dummyflasher.max_data_read = spi_max_read;
+	if (spi_max_write) {
+		spi_programmer_dummyflasher.max_data_write = spi_max_write;
+		spi_write_256_chunksize = min(spi_write_256_chunksize, spi_max_write);
+	}
 	return 0;
 }
 
+/* Let the time pass that a transaction of @bytes bytes takes on the emulated transport. */
+static void spi_transfer_delay(unsigned int bytes)
+{
+	uint64_t ns = (uint64_t)spi_latency * 1000;
+	unsigned int us;
+
+	if (emu_clock == EMU_CLOCK_NONE)
+		return;
+	if (spi_bandwidth)
+		ns += (uint64_t)bytes * 1000000000 / spi_bandwidth;
+	/* Only whole microseconds pass, the rest is carried over to the next transaction. */
+	us = (spi_transfer_ns + ns) / 1000 - spi_transfer_ns / 1000;
+	spi_transfer_ns += ns;
+	if (emu_clock == EMU_CLOCK_VIRTUAL)
+		emu_virtual_us += us;
+	else if (us)
+		internal_delay(us);
+}
+
+void dummy_delay(int usecs)
+{
+	if (emu_clock == EMU_CLOCK_VIRTUAL) {
+		emu_virtual_us += usecs;
+		return;
+	}
+	internal_delay(usecs);
+}
+
+#if EMULATE_SPI_CHIP
+
+/* Keep WIP set for @usecs from now on. */
+static void emu_start_busy(unsigned int usecs)
+{
+	if (!usecs || emu_clock == EMU_CLOCK_NONE)
+		return;
+	emu_status |= SPI_SR_WIP;
+	emu_busy_until = emu_now() + usecs;
+}
+
+static void emu_start_erase(unsigned int size)
+{
+	if (size == emu_chip_size)
+		emu_start_busy(emu_time_erase_chip);
+	else if (size == 4 * 1024)
+		emu_start_busy(emu_time_erase_4k);
+	else if (size == 32 * 1024)
+		emu_start_busy(emu_time_erase_32k);
+	else if (size == 64 * 1024)
+		emu_start_busy(emu_time_erase_64k);
+}
+#endif
+
 int dummy_init(void)
 {
 	char *bustext = NULL;
@@ -202,6 +387,7 @@ int dummy_init(void)
 		msg_pdbg("Support for all flash bus types disabled.\n");
 	free(bustext);
 
+	spi_write_256_chunksize = 256;
 	tmp = extract_programmer_param("spi_write_256_chunksize");
 	if (tmp) {
 		spi_write_256_chunksize = atoi(tmp);
@@ -284,6 +470,9 @@ int dummy_init(void)
 	}
 	free(tmp);
 
+	if (init_transport())
+		return 1;
+
 #if EMULATE_CHIP
 	tmp = extract_programmer_param("emulate");
 	if (!tmp) {
@@ -518,6 +707,14 @@ static int emulate_spi_chip_response(unsigned int writecnt,
 		}
 	}
 
+	/* A busy chip only answers RDSR. */
+	if (emu_clock != EMU_CLOCK_NONE && (emu_status & SPI_SR_WIP) && emu_now() >= emu_busy_until)
+		emu_status &= ~SPI_SR_WIP;
+	if (emu_clock != EMU_CLOCK_NONE && (emu_status & SPI_SR_WIP) && writearr[0] != JEDEC_RDSR) {
+		msg_perr("Opcode 0x%02x attempted while the chip is busy!\n", writearr[0]);
+		return 0;
+	}
+
 	if (emu_max_aai_size && (emu_status & SPI_SR_AAI)) {
 		if (writearr[0] != JEDEC_AAI_WORD_PROGRAM &&
 		    writearr[0] != JEDEC_WRDI &&
@@ -638,6 +835,7 @@ static int emulate_spi_chip_response(unsigned int writecnt,
 			return 1;
 		}
 		memcpy(flashchip_contents + offs, writearr + 4, writecnt - 4);
+		emu_start_busy(emu_time_program);
 		break;
 	case JEDEC_AAI_WORD_PROGRAM:
 		if (!emu_max_aai_size)
@@ -674,6 +872,7 @@ static int emulate_spi_chip_response(unsigned int writecnt,
 			memcpy(flashchip_contents + aai_offs, writearr + 1, 2);
 			aai_offs += 2;
 		}
+		emu_start_busy(emu_time_program);
 		break;
 	case JEDEC_WRDI:
 		if (emu_max_aai_size)
@@ -695,6 +894,7 @@ static int emulate_spi_chip_response(unsigned int writecnt,
 			msg_pdbg("Unaligned SECTOR ERASE 0x20: 0x%x\n", offs);
 		offs &= ~(emu_jedec_se_size - 1);
 		memset(flashchip_contents + offs, 0xff, emu_jedec_se_size);
+		emu_start_erase(emu_jedec_se_size);
 		break;
 	case JEDEC_BE_52:
 		if (!emu_jedec_be_52_size)
@@ -712,6 +912,7 @@ static int emulate_spi_chip_response(unsigned int writecnt,
 			msg_pdbg("Unaligned BLOCK ERASE 0x52: 0x%x\n", offs);
 		offs &= ~(emu_jedec_be_52_size - 1);
 		memset(flashchip_contents + offs, 0xff, emu_jedec_be_52_size);
+		emu_start_erase(emu_jedec_be_52_size);
 		break;
 	case JEDEC_BE_D8:
 		if (!emu_jedec_be_d8_size)
@@ -729,6 +930,7 @@ static int emulate_spi_chip_response(unsigned int writecnt,
 			msg_pdbg("Unaligned BLOCK ERASE 0xd8: 0x%x\n", offs);
 		offs &= ~(emu_jedec_be_d8_size - 1);
 		memset(flashchip_contents + offs, 0xff, emu_jedec_be_d8_size);
+		emu_start_erase(emu_jedec_be_d8_size);
 		break;
 	case JEDEC_CE_60:
 		if (!emu_jedec_ce_60_size)
@@ -744,6 +946,7 @@ static int emulate_spi_chip_response(unsigned int writecnt,
 		/* JEDEC_CE_60_OUTSIZE is 1 (no address) -> no offset. */
 		/* emu_jedec_ce_60_size is emu_chip_size. */
 		memset(flashchip_contents, 0xff, emu_jedec_ce_60_size);
+		emu_start_erase(emu_jedec_ce_60_size);
 		break;
 	case JEDEC_CE_C7:
 		if (!emu_jedec_ce_c7_size)
@@ -759,6 +962,7 @@ static int emulate_spi_chip_response(unsigned int writecnt,
 		/* JEDEC_CE_C7_OUTSIZE is 1 (no address) -> no offset. */
 		/* emu_jedec_ce_c7_size is emu_chip_size. */
 		memset(flashchip_contents, 0xff, emu_jedec_ce_c7_size);
+		emu_start_erase(emu_jedec_ce_c7_size);
 		break;
 	case JEDEC_SFDP:
 		if (emu_chip != EMULATE_MACRONIX_MX25L6436)
@@ -818,6 +1022,15 @@ static int dummy_spi_send_command(struct flashctx *flash, unsigned int writecnt,
 	for (i = 0; i < writecnt; i++)
 		msg_pspew(" 0x%02x", writearr[i]);
 
+	/* Write limits apply to the data after the opcode and the address. */
+	if ((spi_max_read && readcnt > spi_max_read) ||
+	    (spi_max_write && writecnt > JEDEC_BYTE_PROGRAM_OUTSIZE - 1 + spi_max_write)) {
+		msg_perr("%s: Transfer of %u/%u bytes exceeds the limits of %u/%u bytes.\n", __func__,
+			 writecnt, readcnt, spi_max_write, spi_max_read);
+		return SPI_INVALID_LENGTH;
+	}
+	spi_transfer_delay(writecnt + readcnt);
+
 	/* Response for unknown commands and missing chip is 0xff. */
 	memset(readarr, 0xff, readcnt);
 #if EMULATE_SPI_CHIP
@@ -30,6 +30,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <stdarg.h>
+#include "libflashrom.h"
 #ifdef _WIN32
 #include <windows.h>
 #undef min
@@ -165,9 +166,9 @@ struct flashchip {
 	/*
 	 * Erase blocks and associated erase function. Any chip erase function
 	 * is stored as chip-sized virtual block together with said function.
-	 * The first one that fits will be chosen. There is currently no way to
-	 * influence that behaviour. For testing just comment out the other
-	 * elements or set the function pointer to NULL.
+	 * The erase planner in flashrom.c picks the cheapest combination of
+	 * these for each area that needs to change. For testing just comment
+	 * out the other elements or set the function pointer to NULL.
 	 */
 	struct block_eraser {
 		struct eraseblock{
@@ -188,6 +189,14 @@ struct flashchip {
 		uint16_t max;
 	} voltage;
 	enum write_granularity gran;
+
+	/* Delay in microseconds before verifying a write, for chips which
+	 * need some time to calm down. 0 selects the default, which is no
+	 * delay for SPI chips and one second for all others. Chips whose
+	 * write function polls for completion use TIMING_ZERO.
+	 * NB: negative values have special meanings, see TIMING_* below.
+	 */
+	signed int settle_timing;
 };
 
 struct flashctx {
@@ -196,6 +205,15 @@ struct flashctx {
 	/* Some flash devices have an additional register space. */
 	chipaddr virtual_registers;
 	struct registered_programmer *pgm;
+	/* Reusable buffer, see get_scratch_buffer(). */
+	uint8_t *scratch;
+	unsigned int scratch_size;
+	flashrom_progress_callback *progress_callback;
+	void *progress_data;
+	/* Known chip contents and one validity flag per unit of shadow_unit bytes, see use_shadow. */
+	uint8_t *shadow;
+	uint8_t *shadow_valid;
+	unsigned int shadow_unit;
 };
 
 #define TEST_UNTESTED	0
@@ -229,6 +247,14 @@ struct flashctx {
 #define TIMING_ZERO	-2
 
 extern const struct flashchip flashchips[];
+/* flashchips_index.c, generated at build time by util/flashchips_tool */
+extern const uint16_t flashchips_name_index[];
+extern const unsigned int flashchips_name_index_size;
+extern const uint16_t flashchips_probe_class[];
+extern const unsigned int flashchips_probe_classes;
+extern const uint16_t flashchips_class_start[];
+extern const uint16_t flashchips_class_index[];
+extern const uint16_t flashchips_id_index[];
 
 void chip_writeb(const struct flashctx *flash, uint8_t val, chipaddr addr);
 void chip_writew(const struct flashctx *flash, uint16_t val, chipaddr addr);
@@ -247,25 +273,52 @@ void print_supported_wiki(void);
 /* flashrom.c */
 extern int verbose_screen;
 extern int verbose_logfile;
+extern int verify_all;
+extern int use_shadow;
+extern int show_progress;
+extern unsigned int stream_size;
 extern const char flashrom_version[];
 extern const char *chip_to_probe;
 void map_flash_registers(struct flashctx *flash);
 int read_memmapped(struct flashctx *flash, uint8_t *buf, unsigned int start, unsigned int len);
+int read_flash(struct flashctx *flash, uint8_t *buf, unsigned int start, unsigned int len);
 int erase_flash(struct flashctx *flash);
+int find_flashchip_name(const char *name);
 int probe_flash(struct registered_programmer *pgm, int startchip, struct flashctx *fill_flash, int force);
+int probe_flash_named(struct registered_programmer *pgm, int startchip, struct flashctx *fill_flash, int force,
+		      const char *name);
+int probe_cache_lookup(const struct flashctx *flash, const void *key, unsigned int keylen,
+		       int *ret, void *data, unsigned int datalen);
+void probe_cache_store(const struct flashctx *flash, const void *key, unsigned int keylen,
+		       int ret, const void *data, unsigned int datalen);
+void probe_cache_clear(void);
+void probe_report_ids(const struct flashctx *flash, uint32_t manufacture_id, uint32_t model_id);
 int read_flash_to_file(struct flashctx *flash, const char *filename);
 int min(int a, int b);
 int max(int a, int b);
 void tolower_string(char *str);
 char *extract_param(const char *const *haystack, const char *needle, const char *delim);
 int verify_range(struct flashctx *flash, uint8_t *cmpbuf, unsigned int start, unsigned int len);
+int compare_range(uint8_t *wantbuf, uint8_t *havebuf, unsigned int start, unsigned int len);
+uint8_t *get_scratch_buffer(struct flashctx *flash, unsigned int len);
+void free_shadow(struct flashctx *flash);
+unsigned int get_largest_eraseblock(const struct flashctx *flash, unsigned int limit);
+int write_area_verified(struct flashctx *flash, unsigned int start, unsigned int len, uint8_t *curcontents,
+			uint8_t *newcontents, bool *excluded, int verify_it);
+void free_scratch_buffer(struct flashctx *flash);
 int need_erase(uint8_t *have, uint8_t *want, unsigned int len, enum write_granularity gran);
+unsigned int get_next_write(uint8_t *have, uint8_t *want, unsigned int len, unsigned int *first_start,
+			    enum write_granularity gran, unsigned int window);
 char *strcat_realloc(char *dest, const char *src);
 void print_version(void);
 void print_buildinfo(void);
 void print_banner(void);
 void list_programmers_linebreak(int startcol, int cols, int paren);
 int selfcheck(void);
+int chip_safety_check(const struct flashctx *flash, int force, int read_it, int write_it, int erase_it,
+		      int verify_it);
+int doit_noshutdown(struct flashctx *flash, int force, const char *filename, int read_it, int write_it,
+		    int erase_it, int verify_it);
 int doit(struct flashctx *flash, int force, const char *filename, int read_it, int write_it, int erase_it, int verify_it);
 int read_buf_from_file(unsigned char *buf, unsigned long size, const char *filename);
 int write_buf_to_file(unsigned char *buf, unsigned long size, const char *filename);
@@ -289,6 +342,10 @@ enum test_state {
  */
 #define ERROR_FLASHROM_LIMIT -201
 
+/* cli_daemon.c */
+int run_batch(struct flashctx *flash, int force, int verify_it, const char *path);
+int serve_daemon(struct flashctx *flash, int force, int verify_it, const char *path);
+
 /* cli_output.c */
 #ifndef STANDALONE
 int open_logfile(const char * const filename);
@@ -335,8 +392,30 @@ int process_include_args(void);
 int read_romlayout(char *name);
 int normalize_romentries(const struct flashctx *flash);
 int build_new_image(const struct flashctx *flash, uint8_t *oldcontents, uint8_t *newcontents);
+int build_new_image_window(unsigned int base, unsigned int len, uint8_t *oldcontents, uint8_t *newcontents);
+int layout_has_included_regions(void);
+int get_next_included_region(unsigned int start, chipoff_t *region_start, chipoff_t *region_end);
+void layout_clear_includes(void);
 void layout_cleanup(void);
 
+/* metrics.c */
+enum metrics_phase {
+	METRICS_INIT,
+	METRICS_PROBE,
+	METRICS_READ,
+	METRICS_ERASE,
+	METRICS_WRITE,
+	METRICS_VERIFY,
+	METRICS_PHASES
+};
+uint64_t metrics_time_us(void);
+void metrics_start(void);
+void metrics_add_phase(enum metrics_phase phase, uint64_t start_us, unsigned long bytes);
+void metrics_add_delay(int usecs, uint64_t start_us);
+void metrics_count_spi(const struct flashctx *flash, int multi, unsigned int bytes);
+void metrics_count_parallel(const struct flashctx *flash, unsigned int bytes);
+int metrics_write_json(const char *filename, const char *programmer_name, const char *chip_name);
+
 /* spi.c */
 struct spi_command {
 	unsigned int writecnt;
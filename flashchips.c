@@ -55,6 +55,7 @@ const struct flashchip flashchips[] = {
 	 * .write		= Chip write function
 	 * .read		= Chip read function
 	 * .voltage		= Voltage range in millivolt
+	 * .settle_timing	= Delay before verifying a write
 	 */
 
 	{
@@ -82,6 +83,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -114,6 +116,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4750, 5250}, /* 4.75-5.25V for type -55, others 4.5-5.5V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -146,6 +149,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4750, 5250}, /* 4.75-5.25V for type -55, others 4.5-5.5V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -173,6 +177,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -200,6 +205,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -227,6 +233,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -258,6 +265,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* 3.0-3.6V for type -45R, others 2.7-3.6V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -289,6 +297,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* 3.0-3.6V for type -45R, others 2.7-3.6V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -321,6 +330,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* 3.0-3.6V for type -55, others 2.7-3.6V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -353,6 +363,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* 3.0-3.6V for type -55, others 2.7-3.6V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -385,6 +396,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -417,6 +429,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -448,7 +461,8 @@ const struct flashchip flashchips[] = {
 		},
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
-		.voltage	= {3000, 3600} /* 3.0-3.6V for type -70R, others 2.7-3.6V */
+		.voltage	= {3000, 3600}, /* 3.0-3.6V for type -70R, others 2.7-3.6V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -480,7 +494,8 @@ const struct flashchip flashchips[] = {
 		},
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
-		.voltage	= {3000, 3600} /* 3.0-3.6V for type -70R, others 2.7-3.6V */
+		.voltage	= {3000, 3600}, /* 3.0-3.6V for type -70R, others 2.7-3.6V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -508,6 +523,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* 3.0-3.6V for type -60R, others 2.7-3.6V*/
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -535,6 +551,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* 3.0-3.6V for type -70R, others 2.7-3.6V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -1312,6 +1329,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -1344,6 +1362,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -1371,6 +1390,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -1399,6 +1419,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -2240,6 +2261,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -2264,6 +2286,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec,	/* FIXME */
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -2288,6 +2311,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -2312,6 +2336,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -2747,6 +2772,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -2779,6 +2805,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -2811,6 +2838,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -2836,6 +2864,7 @@ const struct flashchip flashchips[] = {
  		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -2867,6 +2896,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -2898,6 +2928,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -2929,6 +2960,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -2961,6 +2993,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -2997,6 +3030,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -3048,6 +3082,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -3080,6 +3115,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -4610,6 +4646,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -4642,6 +4679,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -4674,6 +4712,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -4704,6 +4743,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_en29lv640b,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -4801,6 +4841,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_m29f400bt,
 		.read		= read_memmapped,
 		.voltage	= {4750, 5250}, /* 4.75-5.25V for type -55, others 4.5-5.5V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -4833,6 +4874,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_m29f400bt,
 		.read		= read_memmapped,
 		.voltage	= {4750, 5250}, /* 4.75-5.25V for type -55, others 4.5-5.5V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -4865,6 +4907,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_m29f400bt, /* Supports a fast mode too */
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* 3.0-3.6V for type -70, others 2.7-3.6V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -4897,6 +4940,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_m29f400bt, /* Supports a fast mode too */
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* 3.0-3.6V for type -70, others 2.7-3.6V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -5348,6 +5392,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4750, 5250}, /* 4.75-5.25V for type -45, others 4.5-5.5V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -5380,6 +5425,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4750, 5250}, /* 4.75-5.25V for type -45, others 4.5-5.5V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -5407,6 +5453,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -5668,6 +5715,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -5695,6 +5743,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -5722,6 +5771,7 @@ const struct flashchip flashchips[] = {
 		},
 		.write		= write_82802ab,
 		.read		= read_memmapped,
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -5745,6 +5795,7 @@ const struct flashchip flashchips[] = {
 		.unlock		= unlock_28f004s5,
 		.write		= write_82802ab,
 		.read		= read_memmapped,
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -5772,6 +5823,7 @@ const struct flashchip flashchips[] = {
 		},
 		.write		= write_82802ab,
 		.read		= read_memmapped,
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -5799,6 +5851,7 @@ const struct flashchip flashchips[] = {
 		},
 		.write		= write_82802ab,
 		.read		= read_memmapped,
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -5827,6 +5880,7 @@ const struct flashchip flashchips[] = {
 		},
 		.write		= write_82802ab,
 		.read		= read_memmapped,
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -5855,6 +5909,7 @@ const struct flashchip flashchips[] = {
 		},
 		.write		= write_82802ab,
 		.read		= read_memmapped,
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -5880,6 +5935,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -5905,6 +5961,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -6727,6 +6784,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -6760,6 +6818,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -6792,6 +6851,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -6824,6 +6884,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -6851,6 +6912,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -6878,6 +6940,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -7950,6 +8013,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -7977,6 +8041,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -8004,6 +8069,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -8031,6 +8097,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -8058,6 +8125,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -8085,6 +8153,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -8112,6 +8181,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -8765,6 +8835,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -8797,6 +8868,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -8827,6 +8899,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -8857,6 +8930,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -8887,6 +8961,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -8917,6 +8992,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -8948,6 +9024,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -8979,6 +9056,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -9166,6 +9244,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -9199,6 +9278,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10009,6 +10089,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_28sf040,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10033,6 +10114,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10057,6 +10139,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10081,6 +10164,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10105,6 +10189,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10132,6 +10217,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10159,6 +10245,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10186,6 +10273,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10213,6 +10301,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10240,6 +10329,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10267,6 +10357,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10294,6 +10385,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10321,6 +10413,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10351,6 +10444,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10383,6 +10477,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10415,6 +10510,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10450,6 +10546,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10483,6 +10580,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10515,6 +10613,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10548,6 +10647,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10581,6 +10681,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10611,6 +10712,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10641,6 +10743,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10671,6 +10774,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10702,6 +10806,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10732,6 +10837,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10765,6 +10871,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10797,6 +10904,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4750, 5250}, /* 4.75-5.25V for type -X, others 4.5-5.5V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10829,6 +10937,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4750, 5250}, /* 4.75-5.25V for type -X, others 4.5-5.5V */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10856,6 +10965,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10889,6 +10999,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_m29f400bt,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 	{
 		/* FIXME: this has WORD/BYTE sequences; 2AA for word, 555 for byte */
@@ -10921,6 +11032,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_m29f400bt,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10948,6 +11060,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10975,6 +11088,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -10999,6 +11113,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {2700, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11032,6 +11147,7 @@ const struct flashchip flashchips[] = {
 		.unlock		= unlock_stm50_uniform,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* Also has 12V fast program & erase */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11065,6 +11181,7 @@ const struct flashchip flashchips[] = {
 		.unlock		= unlock_stm50_uniform,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* Also has 12V fast program & erase */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11098,6 +11215,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* Also has 12V fast program & erase */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11131,6 +11249,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* Also has 12V fast program & erase */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11161,6 +11280,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* Also has 12V fast program & erase */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11186,6 +11306,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* Also has 12V fast program & erase */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11211,6 +11332,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* Also has 12V fast program & erase */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11236,6 +11358,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* Also has 12V fast program & erase */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11261,6 +11384,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* Also has 12V fast program & erase */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11292,6 +11416,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_82802ab,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* Also has 12V fast program & erase */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11319,6 +11444,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11346,6 +11472,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11372,6 +11499,7 @@ const struct flashchip flashchips[] = {
 		},
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11398,6 +11526,7 @@ const struct flashchip flashchips[] = {
 		},
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11425,6 +11554,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11452,6 +11582,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11479,6 +11610,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11506,6 +11638,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11538,6 +11671,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -11570,6 +11704,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12272,6 +12407,7 @@ const struct flashchip flashchips[] = {
 		},
 		.write		= write_jedec,
 		.read		= read_memmapped,
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{/* W29EE011, W29EE012, W29C010M, W29C011A do not support probe_jedec according to the datasheet, but it works for newer(?) steppings. */
@@ -12295,6 +12431,7 @@ const struct flashchip flashchips[] = {
 		},
 		.write		= write_jedec,
 		.read		= read_memmapped,
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12319,6 +12456,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12343,6 +12481,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12371,6 +12510,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12399,6 +12539,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12430,6 +12571,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12461,6 +12603,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12489,6 +12632,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12517,6 +12661,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12545,6 +12690,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12577,6 +12723,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12606,6 +12753,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* Also has 12V fast program */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12634,6 +12782,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* Also has 12V fast program */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12662,6 +12811,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12694,6 +12844,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12718,6 +12869,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {4500, 5500},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12750,6 +12902,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12782,6 +12935,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600},
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12811,6 +12965,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* Also has 12V fast program */
+		.settle_timing	= TIMING_ZERO,
 	},
 
 	{
@@ -12839,6 +12994,7 @@ const struct flashchip flashchips[] = {
 		.write		= write_jedec_1,
 		.read		= read_memmapped,
 		.voltage	= {3000, 3600}, /* Also has 12V fast program */
+		.settle_timing	= TIMING_ZERO,
 	},
 	
 	{
@@ -0,0 +1,1710 @@
+/* This file was generated from flashchips.c by util/flashchips_tool. Do not edit. */
+
+#include "flash.h"
+
+/* Indices into flashchips[], sorted by chip name and then by table order. */
+const uint16_t flashchips_name_index[] = {
+	155,	/* 25F160S33B8 */
+	156,	/* 25F160S33T8 */
+	157,	/* 25F320S33B8 */
+	158,	/* 25F320S33T8 */
+	159,	/* 25F640S33B8 */
+	160,	/* 25F640S33T8 */
+	161,	/* 28F001BN/BX-B */
+	162,	/* 28F001BN/BX-T */
+	163,	/* 28F002BC/BL/BV/BX-T */
+	165,	/* 28F004B5/BE/BV/BX-B */
+	166,	/* 28F004B5/BE/BV/BX-T */
+	164,	/* 28F008S3/S5/SC */
+	167,	/* 28F400BV/BX/CE/CV-B */
+	168,	/* 28F400BV/BX/CE/CV-T */
+	169,	/* 82802AB */
+	170,	/* 82802AC */
+	28,	/* A25L010 */
+	32,	/* A25L016 */
+	29,	/* A25L020 */
+	33,	/* A25L032 */
+	30,	/* A25L040 */
+	16,	/* A25L05PT */
+	17,	/* A25L05PU */
+	31,	/* A25L080 */
+	18,	/* A25L10PT */
+	19,	/* A25L10PU */
+	25,	/* A25L16PT */
+	26,	/* A25L16PU */
+	20,	/* A25L20PT */
+	21,	/* A25L20PU */
+	22,	/* A25L40PT */
+	23,	/* A25L40PU */
+	27,	/* A25L512 */
+	24,	/* A25L80P */
+	35,	/* A25LQ032/A25LQ32A */
+	34,	/* A25LQ16 */
+	36,	/* A25LQ64 */
+	37,	/* A29002B */
+	38,	/* A29002T */
+	39,	/* A29040B */
+	40,	/* A49LF040A */
+	41,	/* AT25DF021 */
+	42,	/* AT25DF041A */
+	43,	/* AT25DF081 */
+	44,	/* AT25DF081A */
+	45,	/* AT25DF161 */
+	46,	/* AT25DF321 */
+	47,	/* AT25DF321A */
+	48,	/* AT25DF641(A) */
+	49,	/* AT25DQ161 */
+	53,	/* AT25F1024(A) */
+	54,	/* AT25F2048 */
+	55,	/* AT25F4096 */
+	50,	/* AT25F512 */
+	51,	/* AT25F512A */
+	52,	/* AT25F512B */
+	56,	/* AT25FS010 */
+	57,	/* AT25FS040 */
+	58,	/* AT26DF041 */
+	59,	/* AT26DF081A */
+	60,	/* AT26DF161 */
+	61,	/* AT26DF161A */
+	62,	/* AT26F004 */
+	64,	/* AT29C010A */
+	65,	/* AT29C020 */
+	66,	/* AT29C040A */
+	63,	/* AT29C512 */
+	67,	/* AT45CS1282 */
+	68,	/* AT45DB011D */
+	69,	/* AT45DB021D */
+	70,	/* AT45DB041D */
+	71,	/* AT45DB081D */
+	72,	/* AT45DB161D */
+	73,	/* AT45DB321C */
+	74,	/* AT45DB321D */
+	75,	/* AT45DB321E */
+	76,	/* AT45DB642D */
+	80,	/* AT49(H)F010 */
+	77,	/* AT49BV512 */
+	78,	/* AT49F002(N) */
+	79,	/* AT49F002(N)T */
+	81,	/* AT49F020 */
+	82,	/* AT49F040 */
+	83,	/* AT49F080 */
+	84,	/* AT49F080T */
+	85,	/* AT49LH002 */
+	1,	/* Am29F002(N)BB */
+	2,	/* Am29F002(N)BT */
+	0,	/* Am29F010A/B */
+	3,	/* Am29F016D */
+	4,	/* Am29F040B */
+	5,	/* Am29F080B */
+	6,	/* Am29LV001BB */
+	7,	/* Am29LV001BT */
+	8,	/* Am29LV002BB */
+	9,	/* Am29LV002BT */
+	10,	/* Am29LV004BB */
+	11,	/* Am29LV004BT */
+	12,	/* Am29LV008BB */
+	13,	/* Am29LV008BT */
+	14,	/* Am29LV040B */
+	15,	/* Am29LV081B */
+	87,	/* BM29F040 */
+	86,	/* CAT28F512 */
+	90,	/* EN25B05 */
+	91,	/* EN25B05T */
+	92,	/* EN25B10 */
+	93,	/* EN25B10T */
+	100,	/* EN25B16 */
+	101,	/* EN25B16T */
+	94,	/* EN25B20 */
+	95,	/* EN25B20T */
+	102,	/* EN25B32 */
+	103,	/* EN25B32T */
+	96,	/* EN25B40 */
+	97,	/* EN25B40T */
+	104,	/* EN25B64 */
+	105,	/* EN25B64T */
+	98,	/* EN25B80 */
+	99,	/* EN25B80T */
+	106,	/* EN25F05 */
+	107,	/* EN25F10 */
+	111,	/* EN25F16 */
+	108,	/* EN25F20 */
+	112,	/* EN25F32 */
+	109,	/* EN25F40 */
+	113,	/* EN25F64 */
+	110,	/* EN25F80 */
+	119,	/* EN25Q128 */
+	116,	/* EN25Q16 */
+	117,	/* EN25Q32(A/B) */
+	114,	/* EN25Q40 */
+	118,	/* EN25Q64 */
+	115,	/* EN25Q80(A) */
+	123,	/* EN25QH128 */
+	120,	/* EN25QH16 */
+	121,	/* EN25QH32 */
+	122,	/* EN25QH64 */
+	124,	/* EN25S10 */
+	128,	/* EN25S16 */
+	125,	/* EN25S20 */
+	129,	/* EN25S32 */
+	126,	/* EN25S40 */
+	130,	/* EN25S64 */
+	127,	/* EN25S80 */
+	132,	/* EN29F002(A)(N)B */
+	133,	/* EN29F002(A)(N)T */
+	131,	/* EN29F010 */
+	134,	/* EN29LV640B */
+	89,	/* F25L008A */
+	88,	/* F49B002UA */
+	141,	/* GD25LQ32 */
+	143,	/* GD25Q10 */
+	150,	/* GD25Q128B */
+	147,	/* GD25Q16(B) */
+	144,	/* GD25Q20(B) */
+	148,	/* GD25Q32(B) */
+	145,	/* GD25Q40(B) */
+	142,	/* GD25Q512 */
+	149,	/* GD25Q64(B) */
+	146,	/* GD25Q80(B) */
+	151,	/* GD25T80 */
+	153,	/* HY29F002B */
+	152,	/* HY29F002T */
+	154,	/* HY29F040A */
+	264,	/* LE25FW203A */
+	265,	/* LE25FW403A */
+	266,	/* LE25FW418A */
+	267,	/* LE25FW806 */
+	268,	/* LE25FW808 */
+	269,	/* LH28F008BJT-BTLZ1 */
+	270,	/* LHF00L04 */
+	199,	/* M25P05 */
+	198,	/* M25P05-A */
+	201,	/* M25P10 */
+	200,	/* M25P10-A */
+	210,	/* M25P128 */
+	207,	/* M25P16 */
+	202,	/* M25P20 */
+	203,	/* M25P20-old */
+	208,	/* M25P32 */
+	204,	/* M25P40 */
+	205,	/* M25P40-old */
+	209,	/* M25P64 */
+	206,	/* M25P80 */
+	211,	/* M25PE10 */
+	215,	/* M25PE16 */
+	212,	/* M25PE20 */
+	213,	/* M25PE40 */
+	214,	/* M25PE80 */
+	217,	/* M25PX16 */
+	218,	/* M25PX32 */
+	219,	/* M25PX64 */
+	216,	/* M25PX80 */
+	321,	/* M29F002B */
+	322,	/* M29F002T/NT */
+	323,	/* M29F040B */
+	324,	/* M29F400BB */
+	325,	/* M29F400BT */
+	326,	/* M29W010B */
+	327,	/* M29W040B */
+	328,	/* M29W512B */
+	220,	/* M45PE10 */
+	224,	/* M45PE16 */
+	221,	/* M45PE20 */
+	222,	/* M45PE40 */
+	223,	/* M45PE80 */
+	329,	/* M50FLW040A */
+	330,	/* M50FLW040B */
+	331,	/* M50FLW080A */
+	332,	/* M50FLW080B */
+	333,	/* M50FW002 */
+	334,	/* M50FW016 */
+	335,	/* M50FW040 */
+	336,	/* M50FW080 */
+	337,	/* M50LPW080 */
+	338,	/* M50LPW116 */
+	135,	/* MBM29F004BC */
+	136,	/* MBM29F004TC */
+	137,	/* MBM29F400BC */
+	138,	/* MBM29F400TC */
+	139,	/* MBM29LV160BE */
+	140,	/* MBM29LV160TE */
+	172,	/* MX25L1005(C)/MX25L1006E */
+	188,	/* MX25L12805(D) */
+	176,	/* MX25L1605 */
+	177,	/* MX25L1605A/MX25L1606E */
+	178,	/* MX25L1605D/MX25L1608D */
+	179,	/* MX25L1635D */
+	180,	/* MX25L1635E */
+	173,	/* MX25L2005(C) */
+	181,	/* MX25L3205(A) */
+	182,	/* MX25L3205D/MX25L3208D */
+	183,	/* MX25L3206E */
+	184,	/* MX25L3235D */
+	174,	/* MX25L4005(A/C) */
+	171,	/* MX25L512(E)/MX25V512(C) */
+	185,	/* MX25L6405(D) */
+	186,	/* MX25L6406E/MX25L6436E */
+	187,	/* MX25L6445E */
+	175,	/* MX25L8005/MX25V8005 */
+	189,	/* MX25U1635E */
+	190,	/* MX25U3235E/F */
+	191,	/* MX25U6435E/F */
+	192,	/* MX29F001B */
+	193,	/* MX29F001T */
+	194,	/* MX29F002(N)B */
+	195,	/* MX29F002(N)T */
+	196,	/* MX29F040 */
+	197,	/* MX29LV040 */
+	225,	/* N25Q016 */
+	226,	/* N25Q032..1E */
+	227,	/* N25Q032..3E */
+	228,	/* N25Q064..1E */
+	229,	/* N25Q064..3E */
+	230,	/* N25Q128..1E */
+	231,	/* N25Q128..3E */
+	239,	/* N25S10 */
+	243,	/* N25S16 */
+	240,	/* N25S20 */
+	241,	/* N25S40 */
+	242,	/* N25S80 */
+	389,	/* Opaque flash chip */
+	246,	/* Pm25LD010(C) */
+	247,	/* Pm25LD020(C) */
+	248,	/* Pm25LD040(C) */
+	244,	/* Pm25LD256C */
+	245,	/* Pm25LD512(C) */
+	250,	/* Pm25LV010 */
+	251,	/* Pm25LV010A */
+	255,	/* Pm25LV016B */
+	252,	/* Pm25LV020 */
+	253,	/* Pm25LV040 */
+	254,	/* Pm25LV080B */
+	249,	/* Pm25LV512(A) */
+	257,	/* Pm29F002B */
+	256,	/* Pm29F002T */
+	258,	/* Pm39LV010 */
+	259,	/* Pm39LV020 */
+	260,	/* Pm39LV040 */
+	261,	/* Pm39LV512 */
+	262,	/* Pm49FL002 */
+	263,	/* Pm49FL004 */
+	271,	/* S25FL004A */
+	272,	/* S25FL008A */
+	273,	/* S25FL016A */
+	274,	/* S25FL032A/P */
+	275,	/* S25FL064A/P */
+	278,	/* S25FL116K/S25FL216K */
+	279,	/* S25FL128S......0 */
+	276,	/* S25FL204K */
+	277,	/* S25FL208K */
+	388,	/* SFDP-capable chip */
+	280,	/* SST25LF040A */
+	281,	/* SST25LF080(A) */
+	282,	/* SST25VF010 */
+	283,	/* SST25VF016B */
+	284,	/* SST25VF032B */
+	286,	/* SST25VF040 */
+	287,	/* SST25VF040B */
+	288,	/* SST25VF040B.REMS */
+	285,	/* SST25VF064C */
+	289,	/* SST25VF080B */
+	291,	/* SST25WF010 */
+	292,	/* SST25WF020 */
+	293,	/* SST25WF040 */
+	290,	/* SST25WF512 */
+	294,	/* SST28SF040A */
+	295,	/* SST29EE010 */
+	297,	/* SST29EE020A */
+	296,	/* SST29LE010 */
+	298,	/* SST29LE020 */
+	300,	/* SST39SF010A */
+	301,	/* SST39SF020A */
+	302,	/* SST39SF040 */
+	299,	/* SST39SF512 */
+	304,	/* SST39VF010 */
+	305,	/* SST39VF020 */
+	306,	/* SST39VF040 */
+	307,	/* SST39VF080 */
+	303,	/* SST39VF512 */
+	308,	/* SST49LF002A/B */
+	309,	/* SST49LF003A/B */
+	310,	/* SST49LF004A/B */
+	311,	/* SST49LF004C */
+	312,	/* SST49LF008A */
+	313,	/* SST49LF008C */
+	314,	/* SST49LF016C */
+	315,	/* SST49LF020 */
+	316,	/* SST49LF020A */
+	317,	/* SST49LF040 */
+	318,	/* SST49LF040B */
+	319,	/* SST49LF080A */
+	320,	/* SST49LF160C */
+	347,	/* TMS29F002RB */
+	348,	/* TMS29F002RT */
+	232,	/* V29C51000B */
+	233,	/* V29C51000T */
+	234,	/* V29C51400B */
+	235,	/* V29C51400T */
+	236,	/* V29LC51000 */
+	237,	/* V29LC51001 */
+	238,	/* V29LC51002 */
+	353,	/* W25Q128.V */
+	350,	/* W25Q16.V */
+	357,	/* W25Q16.W */
+	354,	/* W25Q20.W */
+	351,	/* W25Q32.V */
+	358,	/* W25Q32.W */
+	355,	/* W25Q40.W */
+	352,	/* W25Q64.V */
+	359,	/* W25Q64.W */
+	349,	/* W25Q80.V */
+	356,	/* W25Q80.W */
+	360,	/* W25X10 */
+	364,	/* W25X16 */
+	361,	/* W25X20 */
+	365,	/* W25X32 */
+	362,	/* W25X40 */
+	366,	/* W25X64 */
+	363,	/* W25X80 */
+	368,	/* W29C010(M)/W29C011A/W29EE011/W29EE012 */
+	367,	/* W29C010(M)/W29C011A/W29EE011/W29EE012-old */
+	369,	/* W29C020(C)/W29C022 */
+	370,	/* W29C040/P */
+	371,	/* W39F010 */
+	372,	/* W39L010 */
+	373,	/* W39L020 */
+	374,	/* W39L040 */
+	375,	/* W39V040A */
+	376,	/* W39V040B */
+	377,	/* W39V040C */
+	378,	/* W39V040FA */
+	379,	/* W39V040FB */
+	380,	/* W39V040FC */
+	381,	/* W39V080A */
+	386,	/* W39V080FA */
+	387,	/* W39V080FA (dual mode) */
+	382,	/* W49F002U/N */
+	383,	/* W49F020 */
+	384,	/* W49V002A */
+	385,	/* W49V002FA */
+	390,	/* unknown AMIC SPI chip */
+	391,	/* unknown Atmel SPI chip */
+	392,	/* unknown Eon SPI chip */
+	393,	/* unknown Macronix SPI chip */
+	394,	/* unknown PMC SPI chip */
+	399,	/* unknown SPI chip (RDID) */
+	400,	/* unknown SPI chip (REMS) */
+	395,	/* unknown SST SPI chip */
+	396,	/* unknown ST SPI chip */
+	397,	/* unknown Sanyo SPI chip */
+	398,	/* unknown Winbond (ex Nexcom) SPI chip */
+	339,	/* {F,S,V}29C51001B */
+	340,	/* {F,S,V}29C51001T */
+	341,	/* {F,S,V}29C51002B */
+	342,	/* {F,S,V}29C51002T */
+	343,	/* {F,S,V}29C51004B */
+	344,	/* {F,S,V}29C51004T */
+	345,	/* {S,V}29C31004B */
+	346,	/* {S,V}29C31004T */
+};
+
+const unsigned int flashchips_name_index_size = 401;
+
+/* Entries which send the same ID sequence when probed form a probe class, see
+ * util/flashchips_tool. The class of every flashchips[] entry.
+ */
+const uint16_t flashchips_probe_class[] = {
+	0,	/* Am29F010A/B */
+	1,	/* Am29F002(N)BB */
+	2,	/* Am29F002(N)BT */
+	3,	/* Am29F016D */
+	4,	/* Am29F040B */
+	5,	/* Am29F080B */
+	6,	/* Am29LV001BB */
+	6,	/* Am29LV001BT */
+	1,	/* Am29LV002BB */
+	1,	/* Am29LV002BT */
+	4,	/* Am29LV004BB */
+	4,	/* Am29LV004BT */
+	5,	/* Am29LV008BB */
+	5,	/* Am29LV008BT */
+	4,	/* Am29LV040B */
+	5,	/* Am29LV081B */
+	7,	/* A25L05PT */
+	7,	/* A25L05PU */
+	7,	/* A25L10PT */
+	7,	/* A25L10PU */
+	7,	/* A25L20PT */
+	7,	/* A25L20PU */
+	7,	/* A25L40PT */
+	7,	/* A25L40PU */
+	7,	/* A25L80P */
+	7,	/* A25L16PT */
+	7,	/* A25L16PU */
+	8,	/* A25L512 */
+	8,	/* A25L010 */
+	8,	/* A25L020 */
+	8,	/* A25L040 */
+	8,	/* A25L080 */
+	8,	/* A25L016 */
+	8,	/* A25L032 */
+	8,	/* A25LQ16 */
+	8,	/* A25LQ032/A25LQ32A */
+	8,	/* A25LQ64 */
+	1,	/* A29002B */
+	1,	/* A29002T */
+	4,	/* A29040B */
+	9,	/* A49LF040A */
+	8,	/* AT25DF021 */
+	8,	/* AT25DF041A */
+	8,	/* AT25DF081 */
+	8,	/* AT25DF081A */
+	8,	/* AT25DF161 */
+	8,	/* AT25DF321 */
+	8,	/* AT25DF321A */
+	8,	/* AT25DF641(A) */
+	8,	/* AT25DQ161 */
+	10,	/* AT25F512 */
+	10,	/* AT25F512A */
+	8,	/* AT25F512B */
+	10,	/* AT25F1024(A) */
+	10,	/* AT25F2048 */
+	10,	/* AT25F4096 */
+	8,	/* AT25FS010 */
+	8,	/* AT25FS040 */
+	8,	/* AT26DF041 */
+	8,	/* AT26DF081A */
+	8,	/* AT26DF161 */
+	8,	/* AT26DF161A */
+	8,	/* AT26F004 */
+	11,	/* AT29C512 */
+	12,	/* AT29C010A */
+	13,	/* AT29C020 */
+	14,	/* AT29C040A */
+	8,	/* AT45CS1282 */
+	15,	/* AT45DB011D */
+	15,	/* AT45DB021D */
+	15,	/* AT45DB041D */
+	15,	/* AT45DB081D */
+	15,	/* AT45DB161D */
+	8,	/* AT45DB321C */
+	15,	/* AT45DB321D */
+	15,	/* AT45DB321E */
+	15,	/* AT45DB642D */
+	16,	/* AT49BV512 */
+	17,	/* AT49F002(N) */
+	17,	/* AT49F002(N)T */
+	18,	/* AT49(H)F010 */
+	17,	/* AT49F020 */
+	19,	/* AT49F040 */
+	20,	/* AT49F080 */
+	20,	/* AT49F080T */
+	21,	/* AT49LH002 */
+	16,	/* CAT28F512 */
+	19,	/* BM29F040 */
+	17,	/* F49B002UA */
+	8,	/* F25L008A */
+	8,	/* EN25B05 */
+	8,	/* EN25B05T */
+	8,	/* EN25B10 */
+	8,	/* EN25B10T */
+	8,	/* EN25B20 */
+	8,	/* EN25B20T */
+	8,	/* EN25B40 */
+	8,	/* EN25B40T */
+	8,	/* EN25B80 */
+	8,	/* EN25B80T */
+	8,	/* EN25B16 */
+	8,	/* EN25B16T */
+	8,	/* EN25B32 */
+	8,	/* EN25B32T */
+	8,	/* EN25B64 */
+	8,	/* EN25B64T */
+	8,	/* EN25F05 */
+	8,	/* EN25F10 */
+	8,	/* EN25F20 */
+	8,	/* EN25F40 */
+	8,	/* EN25F80 */
+	8,	/* EN25F16 */
+	8,	/* EN25F32 */
+	8,	/* EN25F64 */
+	8,	/* EN25Q40 */
+	8,	/* EN25Q80(A) */
+	8,	/* EN25Q16 */
+	8,	/* EN25Q32(A/B) */
+	8,	/* EN25Q64 */
+	8,	/* EN25Q128 */
+	8,	/* EN25QH16 */
+	8,	/* EN25QH32 */
+	8,	/* EN25QH64 */
+	8,	/* EN25QH128 */
+	8,	/* EN25S10 */
+	8,	/* EN25S20 */
+	8,	/* EN25S40 */
+	8,	/* EN25S80 */
+	8,	/* EN25S16 */
+	8,	/* EN25S32 */
+	8,	/* EN25S64 */
+	0,	/* EN29F010 */
+	22,	/* EN29F002(A)(N)B */
+	22,	/* EN29F002(A)(N)T */
+	23,	/* EN29LV640B */
+	24,	/* MBM29F004BC */
+	24,	/* MBM29F004TC */
+	25,	/* MBM29F400BC */
+	25,	/* MBM29F400TC */
+	26,	/* MBM29LV160BE */
+	26,	/* MBM29LV160TE */
+	8,	/* GD25LQ32 */
+	8,	/* GD25Q512 */
+	8,	/* GD25Q10 */
+	8,	/* GD25Q20(B) */
+	8,	/* GD25Q40(B) */
+	8,	/* GD25Q80(B) */
+	8,	/* GD25Q16(B) */
+	8,	/* GD25Q32(B) */
+	8,	/* GD25Q64(B) */
+	8,	/* GD25Q128B */
+	8,	/* GD25T80 */
+	17,	/* HY29F002T */
+	17,	/* HY29F002B */
+	24,	/* HY29F040A */
+	8,	/* 25F160S33B8 */
+	8,	/* 25F160S33T8 */
+	8,	/* 25F320S33B8 */
+	8,	/* 25F320S33T8 */
+	8,	/* 25F640S33B8 */
+	8,	/* 25F640S33T8 */
+	18,	/* 28F001BN/BX-B */
+	18,	/* 28F001BN/BX-T */
+	27,	/* 28F002BC/BL/BV/BX-T */
+	28,	/* 28F008S3/S5/SC */
+	28,	/* 28F004B5/BE/BV/BX-B */
+	28,	/* 28F004B5/BE/BV/BX-T */
+	29,	/* 28F400BV/BX/CE/CV-B */
+	29,	/* 28F400BV/BX/CE/CV-T */
+	30,	/* 82802AB */
+	31,	/* 82802AC */
+	8,	/* MX25L512(E)/MX25V512(C) */
+	8,	/* MX25L1005(C)/MX25L1006E */
+	8,	/* MX25L2005(C) */
+	8,	/* MX25L4005(A/C) */
+	8,	/* MX25L8005/MX25V8005 */
+	8,	/* MX25L1605 */
+	8,	/* MX25L1605A/MX25L1606E */
+	8,	/* MX25L1605D/MX25L1608D */
+	8,	/* MX25L1635D */
+	8,	/* MX25L1635E */
+	8,	/* MX25L3205(A) */
+	8,	/* MX25L3205D/MX25L3208D */
+	8,	/* MX25L3206E */
+	8,	/* MX25L3235D */
+	8,	/* MX25L6405(D) */
+	8,	/* MX25L6406E/MX25L6436E */
+	8,	/* MX25L6445E */
+	8,	/* MX25L12805(D) */
+	8,	/* MX25U1635E */
+	8,	/* MX25U3235E/F */
+	8,	/* MX25U6435E/F */
+	6,	/* MX29F001B */
+	6,	/* MX29F001T */
+	1,	/* MX29F002(N)B */
+	1,	/* MX29F002(N)T */
+	4,	/* MX29F040 */
+	4,	/* MX29LV040 */
+	8,	/* M25P05-A */
+	32,	/* M25P05 */
+	8,	/* M25P10-A */
+	32,	/* M25P10 */
+	8,	/* M25P20 */
+	32,	/* M25P20-old */
+	8,	/* M25P40 */
+	32,	/* M25P40-old */
+	8,	/* M25P80 */
+	8,	/* M25P16 */
+	8,	/* M25P32 */
+	8,	/* M25P64 */
+	8,	/* M25P128 */
+	8,	/* M25PE10 */
+	8,	/* M25PE20 */
+	8,	/* M25PE40 */
+	8,	/* M25PE80 */
+	8,	/* M25PE16 */
+	8,	/* M25PX80 */
+	8,	/* M25PX16 */
+	8,	/* M25PX32 */
+	8,	/* M25PX64 */
+	8,	/* M45PE10 */
+	8,	/* M45PE20 */
+	8,	/* M45PE40 */
+	8,	/* M45PE80 */
+	8,	/* M45PE16 */
+	8,	/* N25Q016 */
+	8,	/* N25Q032..1E */
+	8,	/* N25Q032..3E */
+	8,	/* N25Q064..1E */
+	8,	/* N25Q064..3E */
+	8,	/* N25Q128..1E */
+	8,	/* N25Q128..3E */
+	16,	/* V29C51000B */
+	16,	/* V29C51000T */
+	19,	/* V29C51400B */
+	19,	/* V29C51400T */
+	16,	/* V29LC51000 */
+	18,	/* V29LC51001 */
+	17,	/* V29LC51002 */
+	8,	/* N25S10 */
+	8,	/* N25S20 */
+	8,	/* N25S40 */
+	8,	/* N25S80 */
+	8,	/* N25S16 */
+	8,	/* Pm25LD256C */
+	8,	/* Pm25LD512(C) */
+	8,	/* Pm25LD010(C) */
+	8,	/* Pm25LD020(C) */
+	8,	/* Pm25LD040(C) */
+	33,	/* Pm25LV512(A) */
+	33,	/* Pm25LV010 */
+	8,	/* Pm25LV010A */
+	8,	/* Pm25LV020 */
+	8,	/* Pm25LV040 */
+	8,	/* Pm25LV080B */
+	8,	/* Pm25LV016B */
+	34,	/* Pm29F002T */
+	34,	/* Pm29F002B */
+	0,	/* Pm39LV010 */
+	2,	/* Pm39LV020 */
+	24,	/* Pm39LV040 */
+	35,	/* Pm39LV512 */
+	36,	/* Pm49FL002 */
+	37,	/* Pm49FL004 */
+	8,	/* LE25FW203A */
+	8,	/* LE25FW403A */
+	38,	/* LE25FW418A */
+	38,	/* LE25FW806 */
+	38,	/* LE25FW808 */
+	39,	/* LH28F008BJT-BTLZ1 */
+	40,	/* LHF00L04 */
+	8,	/* S25FL004A */
+	8,	/* S25FL008A */
+	8,	/* S25FL016A */
+	8,	/* S25FL032A/P */
+	8,	/* S25FL064A/P */
+	8,	/* S25FL204K */
+	8,	/* S25FL208K */
+	8,	/* S25FL116K/S25FL216K */
+	8,	/* S25FL128S......0 */
+	38,	/* SST25LF040A */
+	38,	/* SST25LF080(A) */
+	41,	/* SST25VF010 */
+	8,	/* SST25VF016B */
+	8,	/* SST25VF032B */
+	8,	/* SST25VF064C */
+	41,	/* SST25VF040 */
+	8,	/* SST25VF040B */
+	41,	/* SST25VF040B.REMS */
+	8,	/* SST25VF080B */
+	8,	/* SST25WF512 */
+	8,	/* SST25WF010 */
+	8,	/* SST25WF020 */
+	8,	/* SST25WF040 */
+	42,	/* SST28SF040A */
+	43,	/* SST29EE010 */
+	43,	/* SST29LE010 */
+	44,	/* SST29EE020A */
+	44,	/* SST29LE020 */
+	45,	/* SST39SF512 */
+	46,	/* SST39SF010A */
+	47,	/* SST39SF020A */
+	48,	/* SST39SF040 */
+	45,	/* SST39VF512 */
+	46,	/* SST39VF010 */
+	47,	/* SST39VF020 */
+	48,	/* SST39VF040 */
+	49,	/* SST39VF080 */
+	50,	/* SST49LF002A/B */
+	51,	/* SST49LF003A/B */
+	52,	/* SST49LF004A/B */
+	30,	/* SST49LF004C */
+	53,	/* SST49LF008A */
+	31,	/* SST49LF008C */
+	54,	/* SST49LF016C */
+	55,	/* SST49LF020 */
+	55,	/* SST49LF020A */
+	56,	/* SST49LF040 */
+	57,	/* SST49LF040B */
+	58,	/* SST49LF080A */
+	59,	/* SST49LF160C */
+	22,	/* M29F002B */
+	22,	/* M29F002T/NT */
+	24,	/* M29F040B */
+	25,	/* M29F400BB */
+	25,	/* M29F400BT */
+	0,	/* M29W010B */
+	24,	/* M29W040B */
+	35,	/* M29W512B */
+	60,	/* M50FLW040A */
+	60,	/* M50FLW040B */
+	61,	/* M50FLW080A */
+	61,	/* M50FLW080B */
+	62,	/* M50FW002 */
+	54,	/* M50FW016 */
+	30,	/* M50FW040 */
+	31,	/* M50FW080 */
+	63,	/* M50LPW080 */
+	64,	/* M50LPW116 */
+	18,	/* {F,S,V}29C51001B */
+	18,	/* {F,S,V}29C51001T */
+	17,	/* {F,S,V}29C51002B */
+	17,	/* {F,S,V}29C51002T */
+	19,	/* {F,S,V}29C51004B */
+	19,	/* {F,S,V}29C51004T */
+	19,	/* {S,V}29C31004B */
+	19,	/* {S,V}29C31004T */
+	2,	/* TMS29F002RB */
+	2,	/* TMS29F002RT */
+	8,	/* W25Q80.V */
+	8,	/* W25Q16.V */
+	8,	/* W25Q32.V */
+	8,	/* W25Q64.V */
+	8,	/* W25Q128.V */
+	8,	/* W25Q20.W */
+	8,	/* W25Q40.W */
+	8,	/* W25Q80.W */
+	8,	/* W25Q16.W */
+	8,	/* W25Q32.W */
+	8,	/* W25Q64.W */
+	8,	/* W25X10 */
+	8,	/* W25X20 */
+	8,	/* W25X40 */
+	8,	/* W25X80 */
+	8,	/* W25X16 */
+	8,	/* W25X32 */
+	8,	/* W25X64 */
+	65,	/* W29C010(M)/W29C011A/W29EE011/W29EE012-old */
+	43,	/* W29C010(M)/W29C011A/W29EE011/W29EE012 */
+	44,	/* W29C020(C)/W29C022 */
+	66,	/* W29C040/P */
+	43,	/* W39F010 */
+	43,	/* W39L010 */
+	44,	/* W39L020 */
+	66,	/* W39L040 */
+	67,	/* W39V040A */
+	67,	/* W39V040B */
+	67,	/* W39V040C */
+	68,	/* W39V040FA */
+	68,	/* W39V040FB */
+	68,	/* W39V040FC */
+	69,	/* W39V080A */
+	44,	/* W49F002U/N */
+	44,	/* W49F020 */
+	70,	/* W49V002A */
+	71,	/* W49V002FA */
+	72,	/* W39V080FA */
+	68,	/* W39V080FA (dual mode) */
+	73,	/* SFDP-capable chip */
+	74,	/* Opaque flash chip */
+	7,	/* unknown AMIC SPI chip */
+	8,	/* unknown Atmel SPI chip */
+	8,	/* unknown Eon SPI chip */
+	8,	/* unknown Macronix SPI chip */
+	8,	/* unknown PMC SPI chip */
+	8,	/* unknown SST SPI chip */
+	8,	/* unknown ST SPI chip */
+	8,	/* unknown Sanyo SPI chip */
+	8,	/* unknown Winbond (ex Nexcom) SPI chip */
+	8,	/* unknown SPI chip (RDID) */
+	41,	/* unknown SPI chip (REMS) */
+};
+
+const unsigned int flashchips_probe_classes = 75;
+
+/* Where each probe class starts in flashchips_class_index[] and flashchips_id_index[]. */
+const uint16_t flashchips_class_start[] = {
+	0,
+	4,
+	11,
+	15,
+	16,
+	23,
+	27,
+	31,
+	43,
+	244,
+	245,
+	250,
+	251,
+	252,
+	253,
+	254,
+	262,
+	267,
+	276,
+	282,
+	290,
+	292,
+	293,
+	297,
+	298,
+	304,
+	308,
+	310,
+	311,
+	314,
+	316,
+	319,
+	322,
+	326,
+	328,
+	330,
+	332,
+	333,
+	334,
+	339,
+	340,
+	341,
+	345,
+	346,
+	351,
+	357,
+	359,
+	361,
+	363,
+	365,
+	366,
+	367,
+	368,
+	369,
+	370,
+	372,
+	374,
+	375,
+	376,
+	377,
+	378,
+	380,
+	382,
+	383,
+	384,
+	385,
+	386,
+	388,
+	391,
+	395,
+	396,
+	397,
+	398,
+	399,
+	400,
+	401,
+};
+
+/* Indices into flashchips[], sorted by probe class and then by table order. */
+const uint16_t flashchips_class_index[] = {
+	0,	/* Am29F010A/B */
+	131,	/* EN29F010 */
+	258,	/* Pm39LV010 */
+	326,	/* M29W010B */
+	1,	/* Am29F002(N)BB */
+	8,	/* Am29LV002BB */
+	9,	/* Am29LV002BT */
+	37,	/* A29002B */
+	38,	/* A29002T */
+	194,	/* MX29F002(N)B */
+	195,	/* MX29F002(N)T */
+	2,	/* Am29F002(N)BT */
+	259,	/* Pm39LV020 */
+	347,	/* TMS29F002RB */
+	348,	/* TMS29F002RT */
+	3,	/* Am29F016D */
+	4,	/* Am29F040B */
+	10,	/* Am29LV004BB */
+	11,	/* Am29LV004BT */
+	14,	/* Am29LV040B */
+	39,	/* A29040B */
+	196,	/* MX29F040 */
+	197,	/* MX29LV040 */
+	5,	/* Am29F080B */
+	12,	/* Am29LV008BB */
+	13,	/* Am29LV008BT */
+	15,	/* Am29LV081B */
+	6,	/* Am29LV001BB */
+	7,	/* Am29LV001BT */
+	192,	/* MX29F001B */
+	193,	/* MX29F001T */
+	16,	/* A25L05PT */
+	17,	/* A25L05PU */
+	18,	/* A25L10PT */
+	19,	/* A25L10PU */
+	20,	/* A25L20PT */
+	21,	/* A25L20PU */
+	22,	/* A25L40PT */
+	23,	/* A25L40PU */
+	24,	/* A25L80P */
+	25,	/* A25L16PT */
+	26,	/* A25L16PU */
+	390,	/* unknown AMIC SPI chip */
+	27,	/* A25L512 */
+	28,	/* A25L010 */
+	29,	/* A25L020 */
+	30,	/* A25L040 */
+	31,	/* A25L080 */
+	32,	/* A25L016 */
+	33,	/* A25L032 */
+	34,	/* A25LQ16 */
+	35,	/* A25LQ032/A25LQ32A */
+	36,	/* A25LQ64 */
+	41,	/* AT25DF021 */
+	42,	/* AT25DF041A */
+	43,	/* AT25DF081 */
+	44,	/* AT25DF081A */
+	45,	/* AT25DF161 */
+	46,	/* AT25DF321 */
+	47,	/* AT25DF321A */
+	48,	/* AT25DF641(A) */
+	49,	/* AT25DQ161 */
+	52,	/* AT25F512B */
+	56,	/* AT25FS010 */
+	57,	/* AT25FS040 */
+	58,	/* AT26DF041 */
+	59,	/* AT26DF081A */
+	60,	/* AT26DF161 */
+	61,	/* AT26DF161A */
+	62,	/* AT26F004 */
+	67,	/* AT45CS1282 */
+	73,	/* AT45DB321C */
+	89,	/* F25L008A */
+	90,	/* EN25B05 */
+	91,	/* EN25B05T */
+	92,	/* EN25B10 */
+	93,	/* EN25B10T */
+	94,	/* EN25B20 */
+	95,	/* EN25B20T */
+	96,	/* EN25B40 */
+	97,	/* EN25B40T */
+	98,	/* EN25B80 */
+	99,	/* EN25B80T */
+	100,	/* EN25B16 */
+	101,	/* EN25B16T */
+	102,	/* EN25B32 */
+	103,	/* EN25B32T */
+	104,	/* EN25B64 */
+	105,	/* EN25B64T */
+	106,	/* EN25F05 */
+	107,	/* EN25F10 */
+	108,	/* EN25F20 */
+	109,	/* EN25F40 */
+	110,	/* EN25F80 */
+	111,	/* EN25F16 */
+	112,	/* EN25F32 */
+	113,	/* EN25F64 */
+	114,	/* EN25Q40 */
+	115,	/* EN25Q80(A) */
+	116,	/* EN25Q16 */
+	117,	/* EN25Q32(A/B) */
+	118,	/* EN25Q64 */
+	119,	/* EN25Q128 */
+	120,	/* EN25QH16 */
+	121,	/* EN25QH32 */
+	122,	/* EN25QH64 */
+	123,	/* EN25QH128 */
+	124,	/* EN25S10 */
+	125,	/* EN25S20 */
+	126,	/* EN25S40 */
+	127,	/* EN25S80 */
+	128,	/* EN25S16 */
+	129,	/* EN25S32 */
+	130,	/* EN25S64 */
+	141,	/* GD25LQ32 */
+	142,	/* GD25Q512 */
+	143,	/* GD25Q10 */
+	144,	/* GD25Q20(B) */
+	145,	/* GD25Q40(B) */
+	146,	/* GD25Q80(B) */
+	147,	/* GD25Q16(B) */
+	148,	/* GD25Q32(B) */
+	149,	/* GD25Q64(B) */
+	150,	/* GD25Q128B */
+	151,	/* GD25T80 */
+	155,	/* 25F160S33B8 */
+	156,	/* 25F160S33T8 */
+	157,	/* 25F320S33B8 */
+	158,	/* 25F320S33T8 */
+	159,	/* 25F640S33B8 */
+	160,	/* 25F640S33T8 */
+	171,	/* MX25L512(E)/MX25V512(C) */
+	172,	/* MX25L1005(C)/MX25L1006E */
+	173,	/* MX25L2005(C) */
+	174,	/* MX25L4005(A/C) */
+	175,	/* MX25L8005/MX25V8005 */
+	176,	/* MX25L1605 */
+	177,	/* MX25L1605A/MX25L1606E */
+	178,	/* MX25L1605D/MX25L1608D */
+	179,	/* MX25L1635D */
+	180,	/* MX25L1635E */
+	181,	/* MX25L3205(A) */
+	182,	/* MX25L3205D/MX25L3208D */
+	183,	/* MX25L3206E */
+	184,	/* MX25L3235D */
+	185,	/* MX25L6405(D) */
+	186,	/* MX25L6406E/MX25L6436E */
+	187,	/* MX25L6445E */
+	188,	/* MX25L12805(D) */
+	189,	/* MX25U1635E */
+	190,	/* MX25U3235E/F */
+	191,	/* MX25U6435E/F */
+	198,	/* M25P05-A */
+	200,	/* M25P10-A */
+	202,	/* M25P20 */
+	204,	/* M25P40 */
+	206,	/* M25P80 */
+	207,	/* M25P16 */
+	208,	/* M25P32 */
+	209,	/* M25P64 */
+	210,	/* M25P128 */
+	211,	/* M25PE10 */
+	212,	/* M25PE20 */
+	213,	/* M25PE40 */
+	214,	/* M25PE80 */
+	215,	/* M25PE16 */
+	216,	/* M25PX80 */
+	217,	/* M25PX16 */
+	218,	/* M25PX32 */
+	219,	/* M25PX64 */
+	220,	/* M45PE10 */
+	221,	/* M45PE20 */
+	222,	/* M45PE40 */
+	223,	/* M45PE80 */
+	224,	/* M45PE16 */
+	225,	/* N25Q016 */
+	226,	/* N25Q032..1E */
+	227,	/* N25Q032..3E */
+	228,	/* N25Q064..1E */
+	229,	/* N25Q064..3E */
+	230,	/* N25Q128..1E */
+	231,	/* N25Q128..3E */
+	239,	/* N25S10 */
+	240,	/* N25S20 */
+	241,	/* N25S40 */
+	242,	/* N25S80 */
+	243,	/* N25S16 */
+	244,	/* Pm25LD256C */
+	245,	/* Pm25LD512(C) */
+	246,	/* Pm25LD010(C) */
+	247,	/* Pm25LD020(C) */
+	248,	/* Pm25LD040(C) */
+	251,	/* Pm25LV010A */
+	252,	/* Pm25LV020 */
+	253,	/* Pm25LV040 */
+	254,	/* Pm25LV080B */
+	255,	/* Pm25LV016B */
+	264,	/* LE25FW203A */
+	265,	/* LE25FW403A */
+	271,	/* S25FL004A */
+	272,	/* S25FL008A */
+	273,	/* S25FL016A */
+	274,	/* S25FL032A/P */
+	275,	/* S25FL064A/P */
+	276,	/* S25FL204K */
+	277,	/* S25FL208K */
+	278,	/* S25FL116K/S25FL216K */
+	279,	/* S25FL128S......0 */
+	283,	/* SST25VF016B */
+	284,	/* SST25VF032B */
+	285,	/* SST25VF064C */
+	287,	/* SST25VF040B */
+	289,	/* SST25VF080B */
+	290,	/* SST25WF512 */
+	291,	/* SST25WF010 */
+	292,	/* SST25WF020 */
+	293,	/* SST25WF040 */
+	349,	/* W25Q80.V */
+	350,	/* W25Q16.V */
+	351,	/* W25Q32.V */
+	352,	/* W25Q64.V */
+	353,	/* W25Q128.V */
+	354,	/* W25Q20.W */
+	355,	/* W25Q40.W */
+	356,	/* W25Q80.W */
+	357,	/* W25Q16.W */
+	358,	/* W25Q32.W */
+	359,	/* W25Q64.W */
+	360,	/* W25X10 */
+	361,	/* W25X20 */
+	362,	/* W25X40 */
+	363,	/* W25X80 */
+	364,	/* W25X16 */
+	365,	/* W25X32 */
+	366,	/* W25X64 */
+	391,	/* unknown Atmel SPI chip */
+	392,	/* unknown Eon SPI chip */
+	393,	/* unknown Macronix SPI chip */
+	394,	/* unknown PMC SPI chip */
+	395,	/* unknown SST SPI chip */
+	396,	/* unknown ST SPI chip */
+	397,	/* unknown Sanyo SPI chip */
+	398,	/* unknown Winbond (ex Nexcom) SPI chip */
+	399,	/* unknown SPI chip (RDID) */
+	40,	/* A49LF040A */
+	50,	/* AT25F512 */
+	51,	/* AT25F512A */
+	53,	/* AT25F1024(A) */
+	54,	/* AT25F2048 */
+	55,	/* AT25F4096 */
+	63,	/* AT29C512 */
+	64,	/* AT29C010A */
+	65,	/* AT29C020 */
+	66,	/* AT29C040A */
+	68,	/* AT45DB011D */
+	69,	/* AT45DB021D */
+	70,	/* AT45DB041D */
+	71,	/* AT45DB081D */
+	72,	/* AT45DB161D */
+	74,	/* AT45DB321D */
+	75,	/* AT45DB321E */
+	76,	/* AT45DB642D */
+	77,	/* AT49BV512 */
+	86,	/* CAT28F512 */
+	232,	/* V29C51000B */
+	233,	/* V29C51000T */
+	236,	/* V29LC51000 */
+	78,	/* AT49F002(N) */
+	79,	/* AT49F002(N)T */
+	81,	/* AT49F020 */
+	88,	/* F49B002UA */
+	152,	/* HY29F002T */
+	153,	/* HY29F002B */
+	238,	/* V29LC51002 */
+	341,	/* {F,S,V}29C51002B */
+	342,	/* {F,S,V}29C51002T */
+	80,	/* AT49(H)F010 */
+	161,	/* 28F001BN/BX-B */
+	162,	/* 28F001BN/BX-T */
+	237,	/* V29LC51001 */
+	339,	/* {F,S,V}29C51001B */
+	340,	/* {F,S,V}29C51001T */
+	82,	/* AT49F040 */
+	87,	/* BM29F040 */
+	234,	/* V29C51400B */
+	235,	/* V29C51400T */
+	343,	/* {F,S,V}29C51004B */
+	344,	/* {F,S,V}29C51004T */
+	345,	/* {S,V}29C31004B */
+	346,	/* {S,V}29C31004T */
+	83,	/* AT49F080 */
+	84,	/* AT49F080T */
+	85,	/* AT49LH002 */
+	132,	/* EN29F002(A)(N)B */
+	133,	/* EN29F002(A)(N)T */
+	321,	/* M29F002B */
+	322,	/* M29F002T/NT */
+	134,	/* EN29LV640B */
+	135,	/* MBM29F004BC */
+	136,	/* MBM29F004TC */
+	154,	/* HY29F040A */
+	260,	/* Pm39LV040 */
+	323,	/* M29F040B */
+	327,	/* M29W040B */
+	137,	/* MBM29F400BC */
+	138,	/* MBM29F400TC */
+	324,	/* M29F400BB */
+	325,	/* M29F400BT */
+	139,	/* MBM29LV160BE */
+	140,	/* MBM29LV160TE */
+	163,	/* 28F002BC/BL/BV/BX-T */
+	164,	/* 28F008S3/S5/SC */
+	165,	/* 28F004B5/BE/BV/BX-B */
+	166,	/* 28F004B5/BE/BV/BX-T */
+	167,	/* 28F400BV/BX/CE/CV-B */
+	168,	/* 28F400BV/BX/CE/CV-T */
+	169,	/* 82802AB */
+	311,	/* SST49LF004C */
+	335,	/* M50FW040 */
+	170,	/* 82802AC */
+	313,	/* SST49LF008C */
+	336,	/* M50FW080 */
+	199,	/* M25P05 */
+	201,	/* M25P10 */
+	203,	/* M25P20-old */
+	205,	/* M25P40-old */
+	249,	/* Pm25LV512(A) */
+	250,	/* Pm25LV010 */
+	256,	/* Pm29F002T */
+	257,	/* Pm29F002B */
+	261,	/* Pm39LV512 */
+	328,	/* M29W512B */
+	262,	/* Pm49FL002 */
+	263,	/* Pm49FL004 */
+	266,	/* LE25FW418A */
+	267,	/* LE25FW806 */
+	268,	/* LE25FW808 */
+	280,	/* SST25LF040A */
+	281,	/* SST25LF080(A) */
+	269,	/* LH28F008BJT-BTLZ1 */
+	270,	/* LHF00L04 */
+	282,	/* SST25VF010 */
+	286,	/* SST25VF040 */
+	288,	/* SST25VF040B.REMS */
+	400,	/* unknown SPI chip (REMS) */
+	294,	/* SST28SF040A */
+	295,	/* SST29EE010 */
+	296,	/* SST29LE010 */
+	368,	/* W29C010(M)/W29C011A/W29EE011/W29EE012 */
+	371,	/* W39F010 */
+	372,	/* W39L010 */
+	297,	/* SST29EE020A */
+	298,	/* SST29LE020 */
+	369,	/* W29C020(C)/W29C022 */
+	373,	/* W39L020 */
+	382,	/* W49F002U/N */
+	383,	/* W49F020 */
+	299,	/* SST39SF512 */
+	303,	/* SST39VF512 */
+	300,	/* SST39SF010A */
+	304,	/* SST39VF010 */
+	301,	/* SST39SF020A */
+	305,	/* SST39VF020 */
+	302,	/* SST39SF040 */
+	306,	/* SST39VF040 */
+	307,	/* SST39VF080 */
+	308,	/* SST49LF002A/B */
+	309,	/* SST49LF003A/B */
+	310,	/* SST49LF004A/B */
+	312,	/* SST49LF008A */
+	314,	/* SST49LF016C */
+	334,	/* M50FW016 */
+	315,	/* SST49LF020 */
+	316,	/* SST49LF020A */
+	317,	/* SST49LF040 */
+	318,	/* SST49LF040B */
+	319,	/* SST49LF080A */
+	320,	/* SST49LF160C */
+	329,	/* M50FLW040A */
+	330,	/* M50FLW040B */
+	331,	/* M50FLW080A */
+	332,	/* M50FLW080B */
+	333,	/* M50FW002 */
+	337,	/* M50LPW080 */
+	338,	/* M50LPW116 */
+	367,	/* W29C010(M)/W29C011A/W29EE011/W29EE012-old */
+	370,	/* W29C040/P */
+	374,	/* W39L040 */
+	375,	/* W39V040A */
+	376,	/* W39V040B */
+	377,	/* W39V040C */
+	378,	/* W39V040FA */
+	379,	/* W39V040FB */
+	380,	/* W39V040FC */
+	387,	/* W39V080FA (dual mode) */
+	381,	/* W39V080A */
+	384,	/* W49V002A */
+	385,	/* W49V002FA */
+	386,	/* W39V080FA */
+	388,	/* SFDP-capable chip */
+	389,	/* Opaque flash chip */
+};
+
+/* Indices into flashchips[], sorted by probe class, manufacture_id, model_id and then by table order. */
+const uint16_t flashchips_id_index[] = {
+	0,	/* Am29F010A/B */
+	326,	/* M29W010B */
+	258,	/* Pm39LV010 */
+	131,	/* EN29F010 */
+	1,	/* Am29F002(N)BB */
+	9,	/* Am29LV002BT */
+	8,	/* Am29LV002BB */
+	37,	/* A29002B */
+	38,	/* A29002T */
+	194,	/* MX29F002(N)B */
+	195,	/* MX29F002(N)T */
+	347,	/* TMS29F002RB */
+	2,	/* Am29F002(N)BT */
+	348,	/* TMS29F002RT */
+	259,	/* Pm39LV020 */
+	3,	/* Am29F016D */
+	14,	/* Am29LV040B */
+	4,	/* Am29F040B */
+	11,	/* Am29LV004BT */
+	10,	/* Am29LV004BB */
+	39,	/* A29040B */
+	197,	/* MX29LV040 */
+	196,	/* MX29F040 */
+	12,	/* Am29LV008BB */
+	15,	/* Am29LV081B */
+	13,	/* Am29LV008BT */
+	5,	/* Am29F080B */
+	6,	/* Am29LV001BB */
+	7,	/* Am29LV001BT */
+	193,	/* MX29F001T */
+	192,	/* MX29F001B */
+	17,	/* A25L05PU */
+	19,	/* A25L10PU */
+	21,	/* A25L20PU */
+	22,	/* A25L40PT */
+	23,	/* A25L40PU */
+	24,	/* A25L80P */
+	26,	/* A25L16PU */
+	16,	/* A25L05PT */
+	18,	/* A25L10PT */
+	20,	/* A25L20PT */
+	25,	/* A25L16PT */
+	390,	/* unknown AMIC SPI chip */
+	271,	/* S25FL004A */
+	272,	/* S25FL008A */
+	273,	/* S25FL016A */
+	274,	/* S25FL032A/P */
+	275,	/* S25FL064A/P */
+	279,	/* S25FL128S......0 */
+	276,	/* S25FL204K */
+	277,	/* S25FL208K */
+	278,	/* S25FL116K/S25FL216K */
+	90,	/* EN25B05 */
+	91,	/* EN25B05T */
+	92,	/* EN25B10 */
+	93,	/* EN25B10T */
+	94,	/* EN25B20 */
+	95,	/* EN25B20T */
+	96,	/* EN25B40 */
+	97,	/* EN25B40T */
+	98,	/* EN25B80 */
+	99,	/* EN25B80T */
+	100,	/* EN25B16 */
+	101,	/* EN25B16T */
+	102,	/* EN25B32 */
+	103,	/* EN25B32T */
+	104,	/* EN25B64 */
+	105,	/* EN25B64T */
+	114,	/* EN25Q40 */
+	115,	/* EN25Q80(A) */
+	116,	/* EN25Q16 */
+	117,	/* EN25Q32(A/B) */
+	118,	/* EN25Q64 */
+	119,	/* EN25Q128 */
+	106,	/* EN25F05 */
+	107,	/* EN25F10 */
+	108,	/* EN25F20 */
+	109,	/* EN25F40 */
+	110,	/* EN25F80 */
+	111,	/* EN25F16 */
+	112,	/* EN25F32 */
+	113,	/* EN25F64 */
+	124,	/* EN25S10 */
+	125,	/* EN25S20 */
+	126,	/* EN25S40 */
+	127,	/* EN25S80 */
+	128,	/* EN25S16 */
+	129,	/* EN25S32 */
+	130,	/* EN25S64 */
+	120,	/* EN25QH16 */
+	121,	/* EN25QH32 */
+	122,	/* EN25QH64 */
+	123,	/* EN25QH128 */
+	392,	/* unknown Eon SPI chip */
+	62,	/* AT26F004 */
+	73,	/* AT45DB321C */
+	67,	/* AT45CS1282 */
+	41,	/* AT25DF021 */
+	58,	/* AT26DF041 */
+	42,	/* AT25DF041A */
+	44,	/* AT25DF081A */
+	59,	/* AT26DF081A */
+	43,	/* AT25DF081 */
+	60,	/* AT26DF161 */
+	61,	/* AT26DF161A */
+	45,	/* AT25DF161 */
+	46,	/* AT25DF321 */
+	47,	/* AT25DF321A */
+	48,	/* AT25DF641(A) */
+	52,	/* AT25F512B */
+	56,	/* AT25FS010 */
+	57,	/* AT25FS040 */
+	49,	/* AT25DQ161 */
+	391,	/* unknown Atmel SPI chip */
+	198,	/* M25P05-A */
+	200,	/* M25P10-A */
+	202,	/* M25P20 */
+	204,	/* M25P40 */
+	206,	/* M25P80 */
+	207,	/* M25P16 */
+	208,	/* M25P32 */
+	209,	/* M25P64 */
+	210,	/* M25P128 */
+	220,	/* M45PE10 */
+	221,	/* M45PE20 */
+	222,	/* M45PE40 */
+	223,	/* M45PE80 */
+	224,	/* M45PE16 */
+	216,	/* M25PX80 */
+	217,	/* M25PX16 */
+	218,	/* M25PX32 */
+	219,	/* M25PX64 */
+	211,	/* M25PE10 */
+	212,	/* M25PE20 */
+	213,	/* M25PE40 */
+	214,	/* M25PE80 */
+	215,	/* M25PE16 */
+	227,	/* N25Q032..3E */
+	229,	/* N25Q064..3E */
+	231,	/* N25Q128..3E */
+	225,	/* N25Q016 */
+	226,	/* N25Q032..1E */
+	228,	/* N25Q064..1E */
+	230,	/* N25Q128..1E */
+	396,	/* unknown ST SPI chip */
+	27,	/* A25L512 */
+	28,	/* A25L010 */
+	29,	/* A25L020 */
+	30,	/* A25L040 */
+	31,	/* A25L080 */
+	32,	/* A25L016 */
+	33,	/* A25L032 */
+	34,	/* A25LQ16 */
+	35,	/* A25LQ032/A25LQ32A */
+	36,	/* A25LQ64 */
+	265,	/* LE25FW403A */
+	264,	/* LE25FW203A */
+	397,	/* unknown Sanyo SPI chip */
+	155,	/* 25F160S33B8 */
+	157,	/* 25F320S33B8 */
+	159,	/* 25F640S33B8 */
+	156,	/* 25F160S33T8 */
+	158,	/* 25F320S33T8 */
+	160,	/* 25F640S33T8 */
+	89,	/* F25L008A */
+	290,	/* SST25WF512 */
+	291,	/* SST25WF010 */
+	292,	/* SST25WF020 */
+	293,	/* SST25WF040 */
+	283,	/* SST25VF016B */
+	284,	/* SST25VF032B */
+	285,	/* SST25VF064C */
+	287,	/* SST25VF040B */
+	289,	/* SST25VF080B */
+	395,	/* unknown SST SPI chip */
+	171,	/* MX25L512(E)/MX25V512(C) */
+	172,	/* MX25L1005(C)/MX25L1006E */
+	173,	/* MX25L2005(C) */
+	174,	/* MX25L4005(A/C) */
+	175,	/* MX25L8005/MX25V8005 */
+	176,	/* MX25L1605 */
+	177,	/* MX25L1605A/MX25L1606E */
+	178,	/* MX25L1605D/MX25L1608D */
+	181,	/* MX25L3205(A) */
+	182,	/* MX25L3205D/MX25L3208D */
+	183,	/* MX25L3206E */
+	185,	/* MX25L6405(D) */
+	186,	/* MX25L6406E/MX25L6436E */
+	187,	/* MX25L6445E */
+	188,	/* MX25L12805(D) */
+	179,	/* MX25L1635D */
+	180,	/* MX25L1635E */
+	189,	/* MX25U1635E */
+	190,	/* MX25U3235E/F */
+	191,	/* MX25U6435E/F */
+	184,	/* MX25L3235D */
+	393,	/* unknown Macronix SPI chip */
+	151,	/* GD25T80 */
+	142,	/* GD25Q512 */
+	143,	/* GD25Q10 */
+	144,	/* GD25Q20(B) */
+	145,	/* GD25Q40(B) */
+	146,	/* GD25Q80(B) */
+	147,	/* GD25Q16(B) */
+	148,	/* GD25Q32(B) */
+	149,	/* GD25Q64(B) */
+	150,	/* GD25Q128B */
+	141,	/* GD25LQ32 */
+	239,	/* N25S10 */
+	240,	/* N25S20 */
+	241,	/* N25S40 */
+	242,	/* N25S80 */
+	243,	/* N25S16 */
+	360,	/* W25X10 */
+	361,	/* W25X20 */
+	362,	/* W25X40 */
+	363,	/* W25X80 */
+	364,	/* W25X16 */
+	365,	/* W25X32 */
+	366,	/* W25X64 */
+	349,	/* W25Q80.V */
+	350,	/* W25Q16.V */
+	351,	/* W25Q32.V */
+	352,	/* W25Q64.V */
+	353,	/* W25Q128.V */
+	354,	/* W25Q20.W */
+	355,	/* W25Q40.W */
+	356,	/* W25Q80.W */
+	357,	/* W25Q16.W */
+	358,	/* W25Q32.W */
+	359,	/* W25Q64.W */
+	398,	/* unknown Winbond (ex Nexcom) SPI chip */
+	254,	/* Pm25LV080B */
+	255,	/* Pm25LV016B */
+	245,	/* Pm25LD512(C) */
+	246,	/* Pm25LD010(C) */
+	247,	/* Pm25LD020(C) */
+	244,	/* Pm25LD256C */
+	251,	/* Pm25LV010A */
+	252,	/* Pm25LV020 */
+	248,	/* Pm25LD040(C) */
+	253,	/* Pm25LV040 */
+	394,	/* unknown PMC SPI chip */
+	399,	/* unknown SPI chip (RDID) */
+	40,	/* A49LF040A */
+	50,	/* AT25F512 */
+	53,	/* AT25F1024(A) */
+	54,	/* AT25F2048 */
+	55,	/* AT25F4096 */
+	51,	/* AT25F512A */
+	63,	/* AT29C512 */
+	64,	/* AT29C010A */
+	65,	/* AT29C020 */
+	66,	/* AT29C040A */
+	68,	/* AT45DB011D */
+	69,	/* AT45DB021D */
+	70,	/* AT45DB041D */
+	71,	/* AT45DB081D */
+	72,	/* AT45DB161D */
+	75,	/* AT45DB321E */
+	74,	/* AT45DB321D */
+	76,	/* AT45DB642D */
+	77,	/* AT49BV512 */
+	86,	/* CAT28F512 */
+	233,	/* V29C51000T */
+	236,	/* V29LC51000 */
+	232,	/* V29C51000B */
+	78,	/* AT49F002(N) */
+	79,	/* AT49F002(N)T */
+	81,	/* AT49F020 */
+	342,	/* {F,S,V}29C51002T */
+	238,	/* V29LC51002 */
+	341,	/* {F,S,V}29C51002B */
+	88,	/* F49B002UA */
+	153,	/* HY29F002B */
+	152,	/* HY29F002T */
+	80,	/* AT49(H)F010 */
+	340,	/* {F,S,V}29C51001T */
+	237,	/* V29LC51001 */
+	339,	/* {F,S,V}29C51001B */
+	162,	/* 28F001BN/BX-T */
+	161,	/* 28F001BN/BX-B */
+	82,	/* AT49F040 */
+	344,	/* {F,S,V}29C51004T */
+	235,	/* V29C51400T */
+	346,	/* {S,V}29C31004T */
+	345,	/* {S,V}29C31004B */
+	343,	/* {F,S,V}29C51004B */
+	234,	/* V29C51400B */
+	87,	/* BM29F040 */
+	83,	/* AT49F080 */
+	84,	/* AT49F080T */
+	85,	/* AT49LH002 */
+	321,	/* M29F002B */
+	322,	/* M29F002T/NT */
+	133,	/* EN29F002(A)(N)T */
+	132,	/* EN29F002(A)(N)B */
+	134,	/* EN29LV640B */
+	136,	/* MBM29F004TC */
+	135,	/* MBM29F004BC */
+	323,	/* M29F040B */
+	327,	/* M29W040B */
+	260,	/* Pm39LV040 */
+	154,	/* HY29F040A */
+	138,	/* MBM29F400TC */
+	137,	/* MBM29F400BC */
+	325,	/* M29F400BT */
+	324,	/* M29F400BB */
+	139,	/* MBM29LV160BE */
+	140,	/* MBM29LV160TE */
+	163,	/* 28F002BC/BL/BV/BX-T */
+	166,	/* 28F004B5/BE/BV/BX-T */
+	165,	/* 28F004B5/BE/BV/BX-B */
+	164,	/* 28F008S3/S5/SC */
+	168,	/* 28F400BV/BX/CE/CV-T */
+	167,	/* 28F400BV/BX/CE/CV-B */
+	335,	/* M50FW040 */
+	169,	/* 82802AB */
+	311,	/* SST49LF004C */
+	336,	/* M50FW080 */
+	170,	/* 82802AC */
+	313,	/* SST49LF008C */
+	199,	/* M25P05 */
+	201,	/* M25P10 */
+	203,	/* M25P20-old */
+	205,	/* M25P40-old */
+	249,	/* Pm25LV512(A) */
+	250,	/* Pm25LV010 */
+	256,	/* Pm29F002T */
+	257,	/* Pm29F002B */
+	328,	/* M29W512B */
+	261,	/* Pm39LV512 */
+	262,	/* Pm49FL002 */
+	263,	/* Pm49FL004 */
+	266,	/* LE25FW418A */
+	268,	/* LE25FW808 */
+	267,	/* LE25FW806 */
+	280,	/* SST25LF040A */
+	281,	/* SST25LF080(A) */
+	269,	/* LH28F008BJT-BTLZ1 */
+	270,	/* LHF00L04 */
+	286,	/* SST25VF040 */
+	282,	/* SST25VF010 */
+	288,	/* SST25VF040B.REMS */
+	400,	/* unknown SPI chip (REMS) */
+	294,	/* SST28SF040A */
+	295,	/* SST29EE010 */
+	296,	/* SST29LE010 */
+	372,	/* W39L010 */
+	371,	/* W39F010 */
+	368,	/* W29C010(M)/W29C011A/W29EE011/W29EE012 */
+	297,	/* SST29EE020A */
+	298,	/* SST29LE020 */
+	382,	/* W49F002U/N */
+	369,	/* W29C020(C)/W29C022 */
+	383,	/* W49F020 */
+	373,	/* W39L020 */
+	299,	/* SST39SF512 */
+	303,	/* SST39VF512 */
+	300,	/* SST39SF010A */
+	304,	/* SST39VF010 */
+	301,	/* SST39SF020A */
+	305,	/* SST39VF020 */
+	302,	/* SST39SF040 */
+	306,	/* SST39VF040 */
+	307,	/* SST39VF080 */
+	308,	/* SST49LF002A/B */
+	309,	/* SST49LF003A/B */
+	310,	/* SST49LF004A/B */
+	312,	/* SST49LF008A */
+	334,	/* M50FW016 */
+	314,	/* SST49LF016C */
+	316,	/* SST49LF020A */
+	315,	/* SST49LF020 */
+	317,	/* SST49LF040 */
+	318,	/* SST49LF040B */
+	319,	/* SST49LF080A */
+	320,	/* SST49LF160C */
+	329,	/* M50FLW040A */
+	330,	/* M50FLW040B */
+	331,	/* M50FLW080A */
+	332,	/* M50FLW080B */
+	333,	/* M50FW002 */
+	337,	/* M50LPW080 */
+	338,	/* M50LPW116 */
+	367,	/* W29C010(M)/W29C011A/W29EE011/W29EE012-old */
+	370,	/* W29C040/P */
+	374,	/* W39L040 */
+	375,	/* W39V040A */
+	377,	/* W39V040C */
+	376,	/* W39V040B */
+	378,	/* W39V040FA */
+	380,	/* W39V040FC */
+	379,	/* W39V040FB */
+	387,	/* W39V080FA (dual mode) */
+	381,	/* W39V080A */
+	384,	/* W49V002A */
+	385,	/* W49V002FA */
+	386,	/* W39V080FA */
+	388,	/* SFDP-capable chip */
+	389,	/* Opaque flash chip */
+};
+
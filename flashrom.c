@@ -37,13 +37,23 @@
 #endif
 #include "flash.h"
 #include "flashchips.h"
+#include "chipdrivers.h"
 #include "programmer.h"
 #include "hwaccess.h"
+#include "spi.h"
 
 const char flashrom_version[] = FLASHROM_VERSION;
 const char *chip_to_probe = NULL;
 int verbose_screen = MSG_INFO;
 int verbose_logfile = MSG_DEBUG2;
+/* If nonzero, verify the whole chip after writing instead of only the touched erase blocks. */
+int verify_all = 0;
+/* Keep a shadow copy of the chip contents during a session, see read_flash_shadowed(). */
+int use_shadow = 0;
+/* If nonzero, write in windows of about this many bytes, see stream_write_flash(). */
+unsigned int stream_size = 0;
+/* Show the progress of long operations, see progress_start(). */
+int show_progress = 0;
 
 static enum programmer programmer = PROGRAMMER_INVALID;
 
@@ -83,7 +93,7 @@ const struct programmer_entry programmer_table[] = {
 		.init			= dummy_init,
 		.map_flash_region	= dummy_map,
 		.unmap_flash_region	= dummy_unmap,
-		.delay			= internal_delay,
+		.delay			= dummy_delay,
 	},
 #endif
 
@@ -370,6 +380,7 @@ int register_shutdown(int (*function) (void *data), void *data)
 
 int programmer_init(enum programmer prog, const char *param)
 {
+	uint64_t start;
 	int ret;
 
 	if (prog >= PROGRAMMER_INVALID) {
@@ -394,7 +405,9 @@ int programmer_init(enum programmer prog, const char *param)
 
 	programmer_param = param;
 	msg_pdbg("Initializing %s programmer\n", programmer_table[programmer].name);
+	start = metrics_time_us();
 	ret = programmer_table[programmer].init();
+	metrics_add_phase(METRICS_INIT, start, 0);
 	if (programmer_param && strlen(programmer_param)) {
 		if (ret != 0) {
 			/* It is quite possible that any unhandled programmer parameter would have been valid,
@@ -414,12 +427,80 @@ int programmer_init(enum programmer prog, const char *param)
 	return ret;
 }
 
+/* Probing maps the same flash window for every flashchips[] entry of a given size, which is a physmap() and
+ * munmap() per entry for the internal programmer. Mappings are therefore cached by (address, size) and only
+ * released when the programmer is shut down, unmapping them before that merely drops them from use.
+ */
+static struct flash_mapping {
+	uintptr_t phys_addr;
+	size_t len;
+	void *virt_addr;
+} *flash_mappings = NULL;
+static int flash_mapping_count = 0;
+
+void *programmer_map_flash_region(const char *descr, uintptr_t phys_addr, size_t len)
+{
+	struct flash_mapping *mapping;
+	void *ret;
+	int i;
+
+	for (i = 0; i < flash_mapping_count; i++) {
+		mapping = &flash_mappings[i];
+		if (mapping->phys_addr == phys_addr && mapping->len == len) {
+			msg_gspew("%s: reusing mapping of %s at 0x%0*" PRIxPTR "\n",
+				  __func__, descr, PRIxPTR_WIDTH, (uintptr_t) mapping->virt_addr);
+			return mapping->virt_addr;
+		}
+	}
+
+	ret = programmer_table[programmer].map_flash_region(descr, phys_addr, len);
+	msg_gspew("%s: mapping %s from 0x%0*" PRIxPTR " to 0x%0*" PRIxPTR "\n",
+		  __func__, descr, PRIxPTR_WIDTH, phys_addr, PRIxPTR_WIDTH, (uintptr_t) ret);
+	if (ret == ERROR_PTR)
+		return ret;
+
+	mapping = realloc(flash_mappings, (flash_mapping_count + 1) * sizeof(*mapping));
+	/* Without a cache entry the mapping is simply released on unmap. */
+	if (!mapping)
+		return ret;
+	flash_mappings = mapping;
+	mapping = &flash_mappings[flash_mapping_count++];
+	mapping->phys_addr = phys_addr;
+	mapping->len = len;
+	mapping->virt_addr = ret;
+	return ret;
+}
+
+void programmer_unmap_flash_region(void *virt_addr, size_t len)
+{
+	int i;
+
+	for (i = 0; i < flash_mapping_count; i++)
+		if (flash_mappings[i].virt_addr == virt_addr && flash_mappings[i].len == len)
+			return;
+	programmer_table[programmer].unmap_flash_region(virt_addr, len);
+}
+
+static void release_flash_mappings(void)
+{
+	int i;
+
+	for (i = 0; i < flash_mapping_count; i++)
+		programmer_table[programmer].unmap_flash_region(flash_mappings[i].virt_addr,
+								flash_mappings[i].len);
+	free(flash_mappings);
+	flash_mappings = NULL;
+	flash_mapping_count = 0;
+}
+
 int programmer_shutdown(void)
 {
 	int ret = 0;
 
 	/* Registering shutdown functions is no longer allowed. */
 	may_register_shutdown = 0;
+	/* The mappings may depend on resources the shutdown functions release. */
+	release_flash_mappings();
 	while (shutdown_fn_count > 0) {
 		int i = --shutdown_fn_count;
 		ret |= shutdown_fn[i].func(shutdown_fn[i].data);
@@ -427,68 +508,168 @@ int programmer_shutdown(void)
 
 	programmer_param = NULL;
 	registered_programmer_count = 0;
+	probe_cache_clear();
 
 	return ret;
 }
 
-void *programmer_map_flash_region(const char *descr, uintptr_t phys_addr, size_t len)
+/* Probing sends the same ID sequences over and over again, because many
+ * flashchips[] entries share a probe function and only differ in the IDs
+ * they expect. The probe functions remember the raw responses here, keyed
+ * by the programmer and a description of the sequence (command, response
+ * length, timing, ...), and compare later entries against the cached answer.
+ * The cache lives until the programmer is shut down.
+ */
+#define PROBE_CACHE_KEYSIZE	16
+#define PROBE_CACHE_DATASIZE	32
+
+static struct probe_cache_entry {
+	const struct registered_programmer *pgm;
+	uint8_t key[PROBE_CACHE_KEYSIZE];
+	unsigned int keylen;
+	int ret;
+	uint8_t data[PROBE_CACHE_DATASIZE];
+	unsigned int datalen;
+} *probe_cache = NULL;
+static int probe_cache_count = 0;
+static int probe_cache_size = 0;
+
+/* Returns 1 and fills in @ret and @data if a response for @key was cached, 0 otherwise. */
+int probe_cache_lookup(const struct flashctx *flash, const void *key, unsigned int keylen,
+		       int *ret, void *data, unsigned int datalen)
 {
-	void *ret = programmer_table[programmer].map_flash_region(descr, phys_addr, len);
-	msg_gspew("%s: mapping %s from 0x%0*" PRIxPTR " to 0x%0*" PRIxPTR "\n",
-		  __func__, descr, PRIxPTR_WIDTH, phys_addr, PRIxPTR_WIDTH, (uintptr_t) ret);
-	return ret;
+	int i;
+
+	for (i = 0; i < probe_cache_count; i++) {
+		const struct probe_cache_entry *entry = &probe_cache[i];
+		if (entry->pgm != flash->pgm || entry->keylen != keylen || entry->datalen != datalen ||
+		    memcmp(entry->key, key, keylen))
+			continue;
+		*ret = entry->ret;
+		memcpy(data, entry->data, datalen);
+		msg_cspew("(cached) ");
+		return 1;
+	}
+	return 0;
 }
 
-void programmer_unmap_flash_region(void *virt_addr, size_t len)
+/* Remember the response to the sequence described by @key. */
+void probe_cache_store(const struct flashctx *flash, const void *key, unsigned int keylen,
+		       int ret, const void *data, unsigned int datalen)
 {
-	programmer_table[programmer].unmap_flash_region(virt_addr, len);
+	struct probe_cache_entry *entry;
+
+	if (keylen > PROBE_CACHE_KEYSIZE || datalen > PROBE_CACHE_DATASIZE)
+		return;
+	if (probe_cache_count == probe_cache_size) {
+		entry = realloc(probe_cache, (probe_cache_size + 32) * sizeof(*entry));
+		/* Not being able to cache is no reason to fail. */
+		if (!entry)
+			return;
+		probe_cache = entry;
+		probe_cache_size += 32;
+	}
+	entry = &probe_cache[probe_cache_count++];
+	entry->pgm = flash->pgm;
+	memcpy(entry->key, key, keylen);
+	entry->keylen = keylen;
+	entry->ret = ret;
+	memcpy(entry->data, data, datalen);
+	entry->datalen = datalen;
+}
+
+/* The IDs the probe functions read, per probe class (see util/flashchips_tool) of flashchips[]. probe_flash()
+ * only probes the members of a class which can match them. Like the cache above, they live until the
+ * programmer is shut down.
+ */
+static struct probe_class_ids {
+	const struct registered_programmer *pgm;	/* NULL if nothing was reported for the class yet */
+	uint32_t manufacture_id;
+	uint32_t model_id;
+} *probe_class_ids = NULL;
+
+/* Set by probe_report_ids() while probe_flash() runs a probe function. */
+static int probe_ids_reported;
+static uint32_t probe_reported_manufacture_id;
+static uint32_t probe_reported_model_id;
+
+/* Probe functions call this with the IDs they read if their result depends on nothing else: They may only
+ * find an entry of flashchips[] if its manufacture_id equals @manufacture_id and its model_id equals
+ * @model_id or is GENERIC_DEVICE_ID, or if its manufacture_id is GENERIC_MANUF_ID.
+ */
+void probe_report_ids(const struct flashctx *flash, uint32_t manufacture_id, uint32_t model_id)
+{
+	probe_ids_reported = 1;
+	probe_reported_manufacture_id = manufacture_id;
+	probe_reported_model_id = model_id;
+}
+
+void probe_cache_clear(void)
+{
+	free(probe_cache);
+	probe_cache = NULL;
+	probe_cache_count = 0;
+	probe_cache_size = 0;
+	free(probe_class_ids);
+	probe_class_ids = NULL;
 }
 
 void chip_writeb(const struct flashctx *flash, uint8_t val, chipaddr addr)
 {
+	metrics_count_parallel(flash, 1);
 	flash->pgm->par.chip_writeb(flash, val, addr);
 }
 
 void chip_writew(const struct flashctx *flash, uint16_t val, chipaddr addr)
 {
+	metrics_count_parallel(flash, 2);
 	flash->pgm->par.chip_writew(flash, val, addr);
 }
 
 void chip_writel(const struct flashctx *flash, uint32_t val, chipaddr addr)
 {
+	metrics_count_parallel(flash, 4);
 	flash->pgm->par.chip_writel(flash, val, addr);
 }
 
 void chip_writen(const struct flashctx *flash, uint8_t *buf, chipaddr addr,
 		 size_t len)
 {
+	metrics_count_parallel(flash, len);
 	flash->pgm->par.chip_writen(flash, buf, addr, len);
 }
 
 uint8_t chip_readb(const struct flashctx *flash, const chipaddr addr)
 {
+	metrics_count_parallel(flash, 1);
 	return flash->pgm->par.chip_readb(flash, addr);
 }
 
 uint16_t chip_readw(const struct flashctx *flash, const chipaddr addr)
 {
+	metrics_count_parallel(flash, 2);
 	return flash->pgm->par.chip_readw(flash, addr);
 }
 
 uint32_t chip_readl(const struct flashctx *flash, const chipaddr addr)
 {
+	metrics_count_parallel(flash, 4);
 	return flash->pgm->par.chip_readl(flash, addr);
 }
 
 void chip_readn(const struct flashctx *flash, uint8_t *buf, chipaddr addr,
 		size_t len)
 {
+	metrics_count_parallel(flash, len);
 	flash->pgm->par.chip_readn(flash, buf, addr, len);
 }
 
 void programmer_delay(int usecs)
 {
+	uint64_t start = metrics_time_us();
+
 	programmer_table[programmer].delay(usecs);
+	metrics_add_delay(usecs, start);
 }
 
 int programmer_highlevel(const struct flashctx *flash, enum highlevel_cmd id, ...)
@@ -633,10 +814,422 @@ static unsigned int count_usable_erasers(const struct flashctx *flash)
 	return usable_erasefunctions;
 }
 
+static unsigned int gcd(unsigned int a, unsigned int b)
+{
+	while (b) {
+		unsigned int t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+/* Returns the largest size every erase block of every usable erase function is a multiple of. */
+static unsigned int get_erase_unit(const struct flashctx *flash)
+{
+	unsigned int unit = 0;
+	int i, k;
+
+	for (k = 0; k < NUM_ERASEFUNCTIONS; k++) {
+		const struct block_eraser *eraser = &flash->chip->block_erasers[k];
+		if (check_block_eraser(flash, k, 0))
+			continue;
+		for (i = 0; i < NUM_ERASEREGIONS; i++)
+			if (eraser->eraseblocks[i].count)
+				unit = gcd(unit, eraser->eraseblocks[i].size);
+	}
+	return unit ? unit : flash->chip->total_size * 1024;
+}
+
+/* Returns the size of the largest erase block of any usable erase function which is at most @limit bytes,
+ * or 0 if there is none.
+ */
+unsigned int get_largest_eraseblock(const struct flashctx *flash, unsigned int limit)
+{
+	unsigned int largest = 0;
+	int i, k;
+
+	for (k = 0; k < NUM_ERASEFUNCTIONS; k++) {
+		const struct block_eraser *eraser = &flash->chip->block_erasers[k];
+		if (check_block_eraser(flash, k, 0))
+			continue;
+		for (i = 0; i < NUM_ERASEREGIONS; i++)
+			if (eraser->eraseblocks[i].count && eraser->eraseblocks[i].size <= limit)
+				largest = max(largest, eraser->eraseblocks[i].size);
+	}
+	return largest;
+}
+
+/* A map with one flag for each unit of the chip as returned by get_erase_unit(). */
+struct blockmap {
+	unsigned int unit;
+	unsigned int count;
+	uint8_t *map;
+};
+
+static int blockmap_init(const struct flashctx *flash, struct blockmap *map)
+{
+	map->unit = get_erase_unit(flash);
+	map->count = flash->chip->total_size * 1024 / map->unit;
+	map->map = calloc(map->count, sizeof(uint8_t));
+	if (!map->map) {
+		msg_gerr("Out of memory!\n");
+		return 1;
+	}
+	return 0;
+}
+
+static void blockmap_free(struct blockmap *map)
+{
+	free(map->map);
+	map->map = NULL;
+}
+
+/* Mark all units which overlap the given range. */
+static void blockmap_set(struct blockmap *map, unsigned int start, unsigned int len)
+{
+	unsigned int i;
+
+	for (i = start / map->unit; i <= (start + len - 1) / map->unit; i++)
+		map->map[i] = 1;
+}
+
+/* Returns 1 if all units which overlap the given range are marked, 0 otherwise. */
+static int blockmap_test(const struct blockmap *map, unsigned int start, unsigned int len)
+{
+	unsigned int i;
+
+	for (i = start / map->unit; i <= (start + len - 1) / map->unit; i++)
+		if (!map->map[i])
+			return 0;
+	return 1;
+}
+
+/* Returns the number of bytes in all marked units. */
+static unsigned int blockmap_bytes(const struct blockmap *map)
+{
+	unsigned int i, n = 0;
+
+	for (i = 0; i < map->count; i++)
+		n += map->map[i];
+	return n * map->unit;
+}
+
+/* Find the next run of marked units at or after @start. Returns its length and updates @start to its
+ * beginning, or returns 0 if there are no more marked units.
+ */
+static unsigned int blockmap_next(const struct blockmap *map, unsigned int *start)
+{
+	unsigned int i = *start / map->unit, j;
+
+	while (i < map->count && !map->map[i])
+		i++;
+	for (j = i; j < map->count && map->map[j]; j++)
+		;
+	*start = i * map->unit;
+	return (j - i) * map->unit;
+}
+
+/* The buffer comparisons below process one 64-bit word at a time and only fall back to single bytes for
+ * the remainder. Loads go through memcpy() so unaligned buffers are fine; compilers turn it into a plain
+ * load and are free to vectorize the loops further.
+ */
+#define BYTES_LOW7	0x7f7f7f7f7f7f7f7fULL
+#define BYTES_HIGH	0x8080808080808080ULL
+
+static inline uint64_t load_word(const uint8_t *buf)
+{
+	uint64_t val;
+
+	memcpy(&val, buf, sizeof(val));
+	return val;
+}
+
+/* Returns a word with the top bit of each byte set if and only if that byte is nonzero in @val. */
+static inline uint64_t nonzero_bytes(uint64_t val)
+{
+	return (((val & BYTES_LOW7) + BYTES_LOW7) | val) & BYTES_HIGH;
+}
+
+/* Returns the offset of the first byte which differs between @a and @b, or @len if they are identical. */
+static unsigned int first_difference(const uint8_t *a, const uint8_t *b, unsigned int len)
+{
+	unsigned int i = 0;
+
+	for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t))
+		if (load_word(a + i) != load_word(b + i))
+			break;
+	for (; i < len; i++)
+		if (a[i] != b[i])
+			break;
+	return i;
+}
+
+/* Returns the number of bytes which differ between @a and @b. */
+static unsigned int count_differences(const uint8_t *a, const uint8_t *b, unsigned int len)
+{
+	unsigned int i = 0, count = 0;
+
+	for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t))
+		count += __builtin_popcountll(nonzero_bytes(load_word(a + i) ^ load_word(b + i)));
+	for (; i < len; i++)
+		if (a[i] != b[i])
+			count++;
+	return count;
+}
+
+/* Returns the number of bytes in @buf which are not in the erased state. */
+static unsigned int count_nonerased(const uint8_t *buf, unsigned int len)
+{
+	unsigned int i = 0, count = 0;
+
+	for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t))
+		count += __builtin_popcountll(nonzero_bytes(~load_word(buf + i)));
+	for (; i < len; i++)
+		if (buf[i] != 0xff)
+			count++;
+	return count;
+}
+
+/* Returns 1 if all @len bytes in @buf are in the erased state, 0 otherwise. */
+static int is_erased(const uint8_t *buf, unsigned int len)
+{
+	unsigned int i = 0;
+
+	for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t))
+		if (load_word(buf + i) != ~0ULL)
+			return 0;
+	for (; i < len; i++)
+		if (buf[i] != 0xff)
+			return 0;
+	return 1;
+}
+
+/* Returns a buffer of at least @len bytes owned by @flash. It is shared by all helpers which need one for a
+ * short time (verification, blank checks, write retries), so the erase/write/verify loops don't have to
+ * allocate anything once it has grown to the largest size needed. It only shrinks when it is freed with the
+ * session, so it stays as large as the largest range verified at once.
+ *
+ * Any call may move the buffer. Holders must therefore only call the chip's read function and pure helpers
+ * like compare_range() until they are done with it, never anything else which may use the scratch buffer
+ * (verify_range(), check_erased_range(), the write helpers) or code outside of flashrom (callbacks).
+ */
+uint8_t *get_scratch_buffer(struct flashctx *flash, unsigned int len)
+{
+	if (len <= flash->scratch_size)
+		return flash->scratch;
+	free(flash->scratch);
+	flash->scratch = malloc(len);
+	if (!flash->scratch) {
+		msg_gerr("Out of memory!\n");
+		exit(1);
+	}
+	flash->scratch_size = len;
+	return flash->scratch;
+}
+
+void free_scratch_buffer(struct flashctx *flash)
+{
+	free(flash->scratch);
+	flash->scratch = NULL;
+	flash->scratch_size = 0;
+}
+
+/* With use_shadow set, each flashctx keeps a copy of the chip contents for the session, with one validity
+ * flag per erase unit. It is filled by the reads of old contents and by verification, and kept up to date by
+ * successful erases and writes, so that later operations in a batch or daemon session don't have to read the
+ * same blocks again. Failed erases and writes invalidate what they touched. Verification always reads the
+ * chip.
+ */
+static int shadow_init(struct flashctx *flash)
+{
+	unsigned int size = flash->chip->total_size * 1024;
+
+	if (flash->shadow)
+		return 0;
+	flash->shadow_unit = get_erase_unit(flash);
+	flash->shadow = malloc(size);
+	flash->shadow_valid = calloc(size / flash->shadow_unit, sizeof(uint8_t));
+	if (!flash->shadow || !flash->shadow_valid) {
+		msg_gerr("Out of memory!\n");
+		exit(1);
+	}
+	return 0;
+}
+
+static void shadow_invalidate(struct flashctx *flash, unsigned int start, unsigned int len)
+{
+	unsigned int i;
+
+	if (!flash->shadow || !len)
+		return;
+	for (i = start / flash->shadow_unit; i <= (start + len - 1) / flash->shadow_unit; i++)
+		flash->shadow_valid[i] = 0;
+}
+
+/* Record that the chip holds @buf at @start. Units which are covered completely become valid, the others
+ * keep their state.
+ */
+static void shadow_update(struct flashctx *flash, unsigned int start, unsigned int len, const uint8_t *buf)
+{
+	unsigned int unit = flash->shadow_unit, i;
+
+	if (!flash->shadow || !len)
+		return;
+	memcpy(flash->shadow + start, buf, len);
+	for (i = (start + unit - 1) / unit; (i + 1) * unit <= start + len; i++)
+		flash->shadow_valid[i] = 1;
+}
+
+/* Progress shown for the reads, erases and writes or verification of one operation. Updates are printed at
+ * most once per interval and not at all for operations finishing within the first one. Operations started
+ * while another one is in progress are part of that and not shown separately.
+ */
+#define PROGRESS_INTERVAL_US	(1000 * 1000)
+/* Reads are split into chunks of this size while their progress is shown. */
+#define PROGRESS_CHUNK		(64 * 1024)
+
+static struct {
+	int depth;
+	int printed;
+	enum flashrom_progress_stage stage;
+	unsigned int total;
+	unsigned int done;
+	unsigned int last_done;
+	uint64_t start_us;
+	uint64_t last_us;
+} progress;
+
+static void progress_start(enum flashrom_progress_stage stage, unsigned int total)
+{
+	if (!show_progress || progress.depth++)
+		return;
+	progress.printed = 0;
+	progress.stage = stage;
+	progress.total = total;
+	progress.done = 0;
+	progress.last_done = 0;
+	progress.start_us = progress.last_us = metrics_time_us();
+}
+
+static void print_progress(uint64_t now)
+{
+	static const char *const done_names[] = {
+		[FLASHROM_PROGRESS_READ]	= "read",
+		[FLASHROM_PROGRESS_WRITE]	= "erased/written",
+		[FLASHROM_PROGRESS_VERIFY]	= "verified",
+	};
+	unsigned int done = min(progress.done, progress.total);
+	/* Bytes per microsecond are MB/s. */
+	double rate = (double)(done - min(progress.last_done, done)) / (now - progress.last_us);
+	double average = (double)done / (now - progress.start_us);
+
+	msg_ginfo("%s%u of %u kB %s (%u%%), %.2f MB/s", progress.printed ? "\r" : "\n", done / 1024,
+		  progress.total / 1024, done_names[progress.stage],
+		  progress.total ? (unsigned int)(100ULL * done / progress.total) : 100, rate);
+	if (done < progress.total && average > 0)
+		msg_ginfo(", ETA %u s   ", (unsigned int)((progress.total - done) / average / 1000000 + 0.5));
+	else
+		msg_ginfo("            ");
+	progress.printed = 1;
+	progress.last_done = done;
+	progress.last_us = now;
+}
+
+/* Account @bytes of @stage, ignored unless they belong to the operation being shown. */
+static void progress_add(enum flashrom_progress_stage stage, unsigned int bytes)
+{
+	uint64_t now;
+
+	if (!progress.depth || stage != progress.stage)
+		return;
+	progress.done += bytes;
+	now = metrics_time_us();
+	if (now - progress.last_us >= PROGRESS_INTERVAL_US)
+		print_progress(now);
+}
+
+static void progress_end(void)
+{
+	if (!progress.depth || --progress.depth)
+		return;
+	/* Leave the final state on screen if anything was printed. */
+	if (!progress.printed)
+		return;
+	if (progress.done != progress.last_done)
+		print_progress(metrics_time_us());
+	msg_ginfo("\n");
+}
+
+/* How much to read at once for @stage: Everything, unless its progress is shown. */
+static unsigned int progress_chunk(enum flashrom_progress_stage stage, unsigned int len)
+{
+	if (progress.depth && stage == progress.stage)
+		return min(PROGRESS_CHUNK, len);
+	return len;
+}
+
+/* flash->chip->read(), accounted as the read phase. */
+int read_flash(struct flashctx *flash, uint8_t *buf, unsigned int start, unsigned int len)
+{
+	uint64_t t = metrics_time_us();
+	unsigned int done, chunk = progress_chunk(FLASHROM_PROGRESS_READ, len);
+	int ret = 0;
+
+	for (done = 0; done < len && !ret; done += chunk) {
+		chunk = min(chunk, len - done);
+		ret = flash->chip->read(flash, buf + done, start + done, chunk);
+		progress_add(FLASHROM_PROGRESS_READ, chunk);
+	}
+	metrics_add_phase(METRICS_READ, t, len);
+	return ret;
+}
+
+/* Like read_flash(), but serves valid parts of the shadow copy from memory. */
+static int read_flash_shadowed(struct flashctx *flash, uint8_t *buf, unsigned int start, unsigned int len)
+{
+	unsigned int unit, end = start + len, pos, next;
+	int valid;
+
+	if (!use_shadow)
+		return read_flash(flash, buf, start, len);
+	shadow_init(flash);
+	unit = flash->shadow_unit;
+	for (pos = start; pos < end; pos = next) {
+		/* Find the run of units with the same state. */
+		valid = flash->shadow_valid[pos / unit];
+		next = (pos / unit + 1) * unit;
+		while (next < end && flash->shadow_valid[next / unit] == valid)
+			next += unit;
+		next = min(next, end);
+		if (valid) {
+			memcpy(buf + pos - start, flash->shadow + pos, next - pos);
+			progress_add(FLASHROM_PROGRESS_READ, next - pos);
+			continue;
+		}
+		if (read_flash(flash, buf + pos - start, pos, next - pos))
+			return 1;
+		shadow_update(flash, pos, next - pos, buf + pos - start);
+	}
+	return 0;
+}
+
+void free_shadow(struct flashctx *flash)
+{
+	free(flash->shadow);
+	free(flash->shadow_valid);
+	flash->shadow = NULL;
+	flash->shadow_valid = NULL;
+}
+
 int compare_range(uint8_t *wantbuf, uint8_t *havebuf, unsigned int start, unsigned int len)
 {
 	int ret = 0, failcount = 0;
 	unsigned int i;
+
+	/* Only look at single bytes if there is a mismatch to report. */
+	if (!memcmp(wantbuf, havebuf, len))
+		return 0;
 	for (i = 0; i < len; i++) {
 		if (wantbuf[i] != havebuf[i]) {
 			/* Only print the first failure. */
@@ -657,17 +1250,31 @@ int compare_range(uint8_t *wantbuf, uint8_t *havebuf, unsigned int start, unsign
 int check_erased_range(struct flashctx *flash, unsigned int start,
 		       unsigned int len)
 {
+	uint8_t *readbuf;
+	unsigned int i;
 	int ret;
-	uint8_t *cmpbuf = malloc(len);
 
-	if (!cmpbuf) {
-		msg_gerr("Could not allocate memory!\n");
-		exit(1);
+	if (!len)
+		return 0;
+	if (!flash->chip->read) {
+		msg_cerr("ERROR: flashrom has no read function for this flash chip.\n");
+		return 1;
 	}
-	memset(cmpbuf, 0xff, len);
-	ret = verify_range(flash, cmpbuf, start, len);
-	free(cmpbuf);
-	return ret;
+	readbuf = get_scratch_buffer(flash, len);
+	ret = flash->chip->read(flash, readbuf, start, len);
+	if (ret) {
+		msg_gerr("Verification impossible because read failed "
+			 "at 0x%x (len 0x%x)\n", start, len);
+		return ret;
+	}
+	if (is_erased(readbuf, len))
+		return 0;
+	/* Report the failure like compare_range() does. */
+	for (i = 0; readbuf[i] == 0xff; i++)
+		;
+	msg_cerr("FAILED at 0x%08x! Expected=0xff, Found=0x%02x, failed byte count from 0x%08x-0x%08x: 0x%x\n",
+		 start + i, readbuf[i], start, start + len - 1, count_nonerased(readbuf, len));
+	return -1;
 }
 
 /*
@@ -679,55 +1286,60 @@ int check_erased_range(struct flashctx *flash, unsigned int start,
  */
 int verify_range(struct flashctx *flash, uint8_t *cmpbuf, unsigned int start, unsigned int len)
 {
-	uint8_t *readbuf = malloc(len);
+	uint8_t *readbuf;
+	unsigned int done, chunk;
+	uint64_t t;
 	int ret = 0;
 
 	if (!len)
-		goto out_free;
+		return 0;
 
 	if (!flash->chip->read) {
 		msg_cerr("ERROR: flashrom has no read function for this flash chip.\n");
 		return 1;
 	}
-	if (!readbuf) {
-		msg_gerr("Could not allocate memory!\n");
-		exit(1);
-	}
 
 	if (start + len > flash->chip->total_size * 1024) {
 		msg_gerr("Error: %s called with start 0x%x + len 0x%x >"
 			" total_size 0x%x\n", __func__, start, len,
 			flash->chip->total_size * 1024);
-		ret = -1;
-		goto out_free;
+		return -1;
 	}
 
-	ret = flash->chip->read(flash, readbuf, start, len);
+	t = metrics_time_us();
+	readbuf = get_scratch_buffer(flash, len);
+	chunk = progress_chunk(FLASHROM_PROGRESS_VERIFY, len);
+	for (done = 0; done < len && !ret; done += chunk) {
+		chunk = min(chunk, len - done);
+		ret = flash->chip->read(flash, readbuf + done, start + done, chunk);
+		progress_add(FLASHROM_PROGRESS_VERIFY, chunk);
+	}
 	if (ret) {
 		msg_gerr("Verification impossible because read failed "
 			 "at 0x%x (len 0x%x)\n", start, len);
+		shadow_invalidate(flash, start, len);
+		metrics_add_phase(METRICS_VERIFY, t, len);
 		return ret;
 	}
+	shadow_update(flash, start, len, readbuf);
 
 	ret = compare_range(cmpbuf, readbuf, start, len);
-out_free:
-	free(readbuf);
+	metrics_add_phase(METRICS_VERIFY, t, len);
 	return ret;
 }
 
 /* Helper function for need_erase() that focuses on granularities of gran bytes. */
 static int need_erase_gran_bytes(uint8_t *have, uint8_t *want, unsigned int len, unsigned int gran)
 {
-	unsigned int i, j, limit;
+	unsigned int j, limit;
 	for (j = 0; j < len / gran; j++) {
 		limit = min (gran, len - j * gran);
 		/* Are 'have' and 'want' identical? */
 		if (!memcmp(have + j * gran, want + j * gran, limit))
 			continue;
 		/* have needs to be in erased state. */
-		for (i = 0; i < limit; i++)
-			if (have[j * gran + i] != 0xff)
-				return 1;
+		if (!is_erased(have + j * gran, limit))
+			return 1;
 	}
 	return 0;
 }
@@ -749,18 +1361,32 @@ static int need_erase_gran_bytes(uint8_t *have, uint8_t *want, unsigned int len,
 int need_erase(uint8_t *have, uint8_t *want, unsigned int len, enum write_granularity gran)
 {
 	int result = 0;
-	unsigned int i;
+	unsigned int i = 0;
+	uint64_t h, w;
 
 	switch (gran) {
 	case write_gran_1bit:
-		for (i = 0; i < len; i++)
+		for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+			h = load_word(have + i);
+			w = load_word(want + i);
+			if ((h & w) != w)
+				return 1;
+		}
+		for (; i < len; i++)
 			if ((have[i] & want[i]) != want[i]) {
 				result = 1;
 				break;
 			}
 		break;
 	case write_gran_1byte:
-		for (i = 0; i < len; i++)
+		/* Any byte which differs has to be erased already. */
+		for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+			h = load_word(have + i);
+			w = load_word(want + i);
+			if (nonzero_bytes(h ^ w) & nonzero_bytes(~h))
+				return 1;
+		}
+		for (; i < len; i++)
 			if ((have[i] != want[i]) && (have[i] != 0xff)) {
 				result = 1;
 				break;
@@ -791,12 +1417,41 @@ int need_erase(uint8_t *have, uint8_t *want, unsigned int len, enum write_granul
 	return result;
 }
 
+/* Returns the size of the chunks in which a chip with granularity @gran is written, or 0 if unknown. */
+static unsigned int get_gran_stride(enum write_granularity gran)
+{
+	switch (gran) {
+	case write_gran_1bit:
+	case write_gran_1byte:
+		return 1;
+	case write_gran_256bytes:
+		return 256;
+	case write_gran_264bytes:
+		return 264;
+	case write_gran_512bytes:
+		return 512;
+	case write_gran_528bytes:
+		return 528;
+	case write_gran_1024bytes:
+		return 1024;
+	case write_gran_1056bytes:
+		return 1056;
+	default:
+		return 0;
+	}
+}
+
 /**
  * Check if the buffer @have needs to be programmed to get the content of @want.
  * If yes, return 1 and fill in first_start with the start address of the
  * write operation and first_len with the length of the first to-be-written
  * chunk. If not, return 0 and leave first_start and first_len undefined.
  *
+ * Nearby chunks are coalesced into one write if they fit into the same
+ * @window (aligned relative to the offset passed in @first_start) and all
+ * bytes in between can safely be written again with their current value,
+ * because resending those bytes is cheaper than another write command.
+ *
  * Warning: This function assumes that @have and @want point to naturally
  * aligned regions.
  *
@@ -804,48 +1459,23 @@ int need_erase(uint8_t *have, uint8_t *want, unsigned int len, enum write_granul
  * @want	buffer with desired content
  * @len		length of the checked area
  * @gran	write granularity (enum, not count)
+ * @window	maximum number of bytes written by a single write command, or 0
+ *		to disable coalescing
  * @first_start	offset of the first byte which needs to be written (passed in
  *		value is increased by the offset of the first needed write
  *		relative to have/want or unchanged if no write is needed)
  * @return	length of the first contiguous area which needs to be written
  *		0 if no write is needed
- *
- * FIXME: This function needs a parameter which tells it about coalescing
- * in relation to the max write length of the programmer and the max write
- * length of the chip.
  */
-static unsigned int get_next_write(uint8_t *have, uint8_t *want, unsigned int len,
-			  unsigned int *first_start,
-			  enum write_granularity gran)
+unsigned int get_next_write(uint8_t *have, uint8_t *want, unsigned int len,
+			    unsigned int *first_start,
+			    enum write_granularity gran, unsigned int window)
 {
-	int need_write = 0;
-	unsigned int rel_start = 0, first_len = 0;
-	unsigned int i, limit, stride;
+	unsigned int base = *first_start;
+	unsigned int rel_start, end, i, limit = 0, nstrides, stride;
 
-	switch (gran) {
-	case write_gran_1bit:
-	case write_gran_1byte:
-		stride = 1;
-		break;
-	case write_gran_256bytes:
-		stride = 256;
-		break;
-	case write_gran_264bytes:
-		stride = 264;
-		break;
-	case write_gran_512bytes:
-		stride = 512;
-		break;
-	case write_gran_528bytes:
-		stride = 528;
-		break;
-	case write_gran_1024bytes:
-		stride = 1024;
-		break;
-	case write_gran_1056bytes:
-		stride = 1056;
-		break;
-	default:
+	stride = get_gran_stride(gran);
+	if (!stride) {
 		msg_cerr("%s: Unsupported granularity! Please report a bug at "
 			 "flashrom@flashrom.org\n", __func__);
 		/* Claim that no write was needed. A write with unknown
@@ -853,28 +1483,55 @@ static unsigned int get_next_write(uint8_t *have, uint8_t *want, unsigned int le
 		 */
 		return 0;
 	}
-	for (i = 0; i < len / stride; i++) {
-		limit = min(stride, len - i * stride);
-		/* Are 'have' and 'want' identical? */
-		if (memcmp(have + i * stride, want + i * stride, limit)) {
-			if (!need_write) {
-				/* First location where have and want differ. */
-				need_write = 1;
-				rel_start = i * stride;
-			}
-		} else {
-			if (need_write) {
-				/* First location where have and want
-				 * do not differ anymore.
-				 */
-				break;
-			}
-		}
+	nstrides = len / stride;
+	/* First location where have and want differ. */
+	i = first_difference(have, want, nstrides * stride) / stride;
+	if (i == nstrides)
+		return 0;
+	rel_start = i * stride;
+	end = i + 1;
+	/* Only coalesce as long as the result still fits into a single write command. */
+	if (window)
+		limit = min((((base + rel_start) / window + 1) * window - base) / stride, nstrides);
+	while (1) {
+		/* Extend the write over all directly following chunks which differ. */
+		while (end < nstrides && memcmp(have + end * stride, want + end * stride, stride))
+			end++;
+		if (!window || end >= limit)
+			break;
+		/* Look for the next differing chunk. Unchanged chunks in between are only
+		 * rewritten if that can not change them: Either they are erased (writing
+		 * all ones is a no-op) or the chip allows to clear each bit individually.
+		 */
+		i = end + first_difference(have + end * stride, want + end * stride,
+					   (limit - end) * stride) / stride;
+		if (i >= limit)
+			break;
+		if (gran != write_gran_1bit && !is_erased(have + end * stride, (i - end) * stride))
+			break;
+		end = i + 1;
 	}
-	if (need_write)
-		first_len = min(i * stride - rel_start, len);
 	*first_start += rel_start;
-	return first_len;
+	return min(end * stride - rel_start, len);
+}
+
+/* Returns the maximum number of bytes a single write command of the programmer carries if nearby writes
+ * should be coalesced, 0 otherwise. Coalescing only helps if this exceeds the write granularity of the chip,
+ * e.g. 256 bytes for all SPI chips, so it depends on the programmer's transfer limit and not on the page size.
+ */
+static unsigned int get_write_window(const struct flashctx *flash)
+{
+	const struct flashchip *chip = flash->chip;
+
+	if (chip->write == spi_chip_write_256) {
+		if (flash->pgm->spi.max_data_write != MAX_DATA_UNSPECIFIED)
+			return flash->pgm->spi.max_data_write;
+	} else if (chip->write == write_opaque) {
+		if (flash->pgm->opaque.max_data_write > 0)
+			return flash->pgm->opaque.max_data_write;
+	}
+	/* Byte and AAI writes need one command per byte or word anyway. */
+	return 0;
 }
 
 /* This function generates various test patterns useful for testing controller
@@ -1062,18 +1719,169 @@ int check_max_decode(enum chipbustype buses, uint32_t size)
 	return 1;
 }
 
+/* Looks up @name in the name index of flashchips[]. Returns the position of the first entry with that name in
+ * flashchips_name_index[] (the other ones follow it), or -1 if there is no such chip.
+ */
+int find_flashchip_name(const char *name)
+{
+	int lo = 0, hi = flashchips_name_index_size;
+
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (strcmp(flashchips[flashchips_name_index[mid]].name, name) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo == flashchips_name_index_size || strcmp(flashchips[flashchips_name_index[lo]].name, name) != 0)
+		return -1;
+	return lo;
+}
+
+/* Returns the first entry of flashchips[] at index @start or later in the @len entries of @index (an index
+ * sorted by table order), -1 if there is none.
+ */
+static int first_from(const uint16_t *index, unsigned int len, int start)
+{
+	unsigned int lo = 0, hi = len;
+
+	while (lo < hi) {
+		unsigned int mid = (lo + hi) / 2;
+		if (index[mid] < start)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return (lo < len) ? index[lo] : -1;
+}
+
+/* Returns the position in flashchips_id_index[] of the first entry of probe class @class whose IDs and index
+ * are not smaller than @manufacture_id, @model_id and @start.
+ */
+static unsigned int id_index_find(unsigned int class, uint32_t manufacture_id, uint32_t model_id, int start)
+{
+	unsigned int lo = flashchips_class_start[class], hi = flashchips_class_start[class + 1];
+
+	while (lo < hi) {
+		unsigned int mid = (lo + hi) / 2;
+		const struct flashchip *chip = &flashchips[flashchips_id_index[mid]];
+		if (chip->manufacture_id != manufacture_id ? chip->manufacture_id < manufacture_id :
+		    chip->model_id != model_id ? chip->model_id < model_id : flashchips_id_index[mid] < start)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+/* Returns the first entry of probe class @class at index @start or later with the given IDs, -1 if none. */
+static int first_with_ids(unsigned int class, uint32_t manufacture_id, uint32_t model_id, int start)
+{
+	unsigned int i = id_index_find(class, manufacture_id, model_id, start);
+	const struct flashchip *chip;
+
+	if (i == flashchips_class_start[class + 1])
+		return -1;
+	chip = &flashchips[flashchips_id_index[i]];
+	if (chip->manufacture_id != manufacture_id || chip->model_id != model_id)
+		return -1;
+	return flashchips_id_index[i];
+}
+
+/* Returns the first entry of probe class @class at index @start or later which can be found by probing @pgm,
+ * -1 if none.
+ */
+static int first_in_probe_class(const struct registered_programmer *pgm, unsigned int class, int start)
+{
+	const struct probe_class_ids *ids = &probe_class_ids[class];
+	unsigned int i, end = flashchips_class_start[class + 1];
+	int first, next;
+
+	if (ids->pgm != pgm)
+		return first_from(flashchips_class_index + flashchips_class_start[class],
+				  end - flashchips_class_start[class], start);
+
+	/* The IDs are known, only look at the entries which can match them (see probe_report_ids()). */
+	first = first_with_ids(class, ids->manufacture_id, ids->model_id, start);
+	next = first_with_ids(class, ids->manufacture_id, GENERIC_DEVICE_ID, start);
+	if (next >= 0 && (first < 0 || next < first))
+		first = next;
+	for (i = id_index_find(class, GENERIC_MANUF_ID, 0, 0); i < end; i++) {
+		next = flashchips_id_index[i];
+		if (flashchips[next].manufacture_id != GENERIC_MANUF_ID)
+			break;
+		if (next >= start && (first < 0 || next < first))
+			first = next;
+	}
+	return first;
+}
+
+/* Returns the first flashchips[] entry at index @start or later that should be probed for, NULL if none.
+ * If @name is not NULL, only entries of that name are. Otherwise the first entry of every probe class is
+ * probed, and of the others only the ones matching the IDs it read.
+ */
+static const struct flashchip *next_probe_candidate(const struct registered_programmer *pgm, int start,
+						    const char *name, int force)
+{
+	unsigned int class;
+	int i, next;
+
+	if (name) {
+		i = find_flashchip_name(name);
+		if (i < 0)
+			return NULL;
+		for (; i < flashchips_name_index_size; i++) {
+			const struct flashchip *chip = &flashchips[flashchips_name_index[i]];
+			if (strcmp(chip->name, name) != 0)
+				break;
+			if (flashchips_name_index[i] >= start)
+				return chip;
+		}
+		return NULL;
+	}
+	/* A forced match takes the first entry with a common bus. */
+	if (force)
+		return flashchips[start].name ? &flashchips[start] : NULL;
+
+	if (!probe_class_ids) {
+		probe_class_ids = calloc(flashchips_probe_classes, sizeof(*probe_class_ids));
+		if (!probe_class_ids) {
+			msg_gerr("Out of memory!\n");
+			exit(1);
+		}
+	}
+	i = -1;
+	for (class = 0; class < flashchips_probe_classes; class++) {
+		/* All members of a class are on the same buses. */
+		if (!(pgm->buses_supported & flashchips[flashchips_class_index[flashchips_class_start[class]]].bustype))
+			continue;
+		next = first_in_probe_class(pgm, class, start);
+		if (next >= 0 && (i < 0 || next < i))
+			i = next;
+	}
+	return (i < 0) ? NULL : &flashchips[i];
+}
+
 int probe_flash(struct registered_programmer *pgm, int startchip, struct flashctx *flash, int force)
+{
+	return probe_flash_named(pgm, startchip, flash, force, chip_to_probe);
+}
+
+/* Like probe_flash(), but probes only for chips called @name (all if NULL) instead of chip_to_probe. */
+int probe_flash_named(struct registered_programmer *pgm, int startchip, struct flashctx *flash, int force,
+		      const char *name)
 {
 	const struct flashchip *chip;
 	unsigned long base = 0;
 	char location[64];
 	uint32_t size;
 	enum chipbustype buses_common;
+	uint64_t t;
+	int found;
 	char *tmp;
 
-	for (chip = flashchips + startchip; chip && chip->name; chip++) {
-		if (chip_to_probe && strcmp(chip->name, chip_to_probe) != 0)
-			continue;
+	for (chip = next_probe_candidate(pgm, startchip, name, force); chip;
+	     chip = next_probe_candidate(pgm, chip - flashchips + 1, name, force)) {
 		buses_common = pgm->buses_supported & chip->bustype;
 		if (!buses_common)
 			continue;
@@ -1104,7 +1912,17 @@ int probe_flash(struct registered_programmer *pgm, int startchip, struct flashct
 		if (force)
 			break;
 
-		if (flash->chip->probe(flash) != 1)
+		t = metrics_time_us();
+		probe_ids_reported = 0;
+		found = flash->chip->probe(flash);
+		metrics_add_phase(METRICS_PROBE, t, 0);
+		if (probe_ids_reported && probe_class_ids) {
+			struct probe_class_ids *ids = &probe_class_ids[flashchips_probe_class[chip - flashchips]];
+			ids->pgm = pgm;
+			ids->manufacture_id = probe_reported_manufacture_id;
+			ids->model_id = probe_reported_model_id;
+		}
+		if (found != 1)
 			goto notfound;
 
 		/* If this is the first chip found, accept it.
@@ -1264,7 +2082,10 @@ int read_flash_to_file(struct flashctx *flash, const char *filename)
 		ret = 1;
 		goto out_free;
 	}
-	if (flash->chip->read(flash, buf, 0, size)) {
+	progress_start(FLASHROM_PROGRESS_READ, size);
+	ret = read_flash_shadowed(flash, buf, 0, size);
+	progress_end();
+	if (ret) {
 		msg_cerr("Read operation failed!\n");
 		ret = 1;
 		goto out_free;
@@ -1277,120 +2098,77 @@ out_free:
 	return ret;
 }
 
-/* This function shares a lot of its structure with erase_and_write_flash() and
- * walk_eraseregions().
- * Even if an error is found, the function will keep going and check the rest.
- */
-static int selfcheck_eraseblocks(const struct flashchip *chip)
-{
-	int i, j, k;
-	int ret = 0;
-
-	for (k = 0; k < NUM_ERASEFUNCTIONS; k++) {
-		unsigned int done = 0;
-		struct block_eraser eraser = chip->block_erasers[k];
-
-		for (i = 0; i < NUM_ERASEREGIONS; i++) {
-			/* Blocks with zero size are bugs in flashchips.c. */
-			if (eraser.eraseblocks[i].count &&
-			    !eraser.eraseblocks[i].size) {
-				msg_gerr("ERROR: Flash chip %s erase function "
-					"%i region %i has size 0. Please report"
-					" a bug at flashrom@flashrom.org\n",
-					chip->name, k, i);
-				ret = 1;
-			}
-			/* Blocks with zero count are bugs in flashchips.c. */
-			if (!eraser.eraseblocks[i].count &&
-			    eraser.eraseblocks[i].size) {
-				msg_gerr("ERROR: Flash chip %s erase function "
-					"%i region %i has count 0. Please report"
-					" a bug at flashrom@flashrom.org\n",
-					chip->name, k, i);
-				ret = 1;
-			}
-			done += eraser.eraseblocks[i].count *
-				eraser.eraseblocks[i].size;
-		}
-		/* Empty eraseblock definition with erase function.  */
-		if (!done && eraser.block_erase)
-			msg_gspew("Strange: Empty eraseblock definition with "
-				  "non-empty erase function. Not an error.\n");
-		if (!done)
-			continue;
-		if (done != chip->total_size * 1024) {
-			msg_gerr("ERROR: Flash chip %s erase function %i "
-				"region walking resulted in 0x%06x bytes total,"
-				" expected 0x%06x bytes. Please report a bug at"
-				" flashrom@flashrom.org\n", chip->name, k,
-				done, chip->total_size * 1024);
-			ret = 1;
-		}
-		if (!eraser.block_erase)
-			continue;
-		/* Check if there are identical erase functions for different
-		 * layouts. That would imply "magic" erase functions. The
-		 * easiest way to check this is with function pointers.
-		 */
-		for (j = k + 1; j < NUM_ERASEFUNCTIONS; j++) {
-			if (eraser.block_erase ==
-			    chip->block_erasers[j].block_erase) {
-				msg_gerr("ERROR: Flash chip %s erase function "
-					"%i and %i are identical. Please report"
-					" a bug at flashrom@flashrom.org\n",
-					chip->name, k, j);
-				ret = 1;
-			}
-		}
-	}
-	return ret;
-}
-
 static int erase_and_write_block_helper(struct flashctx *flash,
 					unsigned int start, unsigned int len,
 					uint8_t *curcontents,
 					uint8_t *newcontents,
 					int (*erasefn) (struct flashctx *flash,
 							unsigned int addr,
-							unsigned int len))
+							unsigned int len),
+					struct blockmap *writemap)
 {
-	unsigned int starthere = 0, lenhere = 0;
+	unsigned int starthere = 0, lenhere = 0, written = 0;
 	int ret = 0, skip = 1, writecount = 0;
 	enum write_granularity gran = flash->chip->gran;
+	uint64_t t;
+	unsigned int window = get_write_window(flash);
 
-	/* curcontents and newcontents are opaque to walk_eraseregions, and
-	 * need to be adjusted here to keep the impression of proper abstraction
-	 */
-	curcontents += start;
-	newcontents += start;
+	/* curcontents and newcontents point to the contents of this block. */
 	msg_cdbg(":");
 	if (need_erase(curcontents, newcontents, len, gran)) {
 		msg_cdbg("E");
+		if (writemap)
+			blockmap_set(writemap, start, len);
+		t = metrics_time_us();
 		ret = erasefn(flash, start, len);
-		if (ret)
+		if (ret) {
+			metrics_add_phase(METRICS_ERASE, t, len);
+			shadow_invalidate(flash, start, len);
 			return ret;
-		if (check_erased_range(flash, start, len)) {
+		}
+		/* Blocks which end up mostly filled with new data are not read back here if they will be
+		 * verified afterwards: A failed erase shows up there as well.
+		 */
+		ret = !(writemap && count_nonerased(newcontents, len) >= len / 2) &&
+		      check_erased_range(flash, start, len);
+		metrics_add_phase(METRICS_ERASE, t, len);
+		if (ret) {
 			msg_cerr("ERASE FAILED!\n");
+			shadow_invalidate(flash, start, len);
 			return -1;
 		}
 		/* Erase was successful. Adjust curcontents. */
 		memset(curcontents, 0xff, len);
+		shadow_update(flash, start, len, curcontents);
 		skip = 0;
 	}
 	/* get_next_write() sets starthere to a new value after the call. */
 	while ((lenhere = get_next_write(curcontents + starthere,
 					 newcontents + starthere,
-					 len - starthere, &starthere, gran))) {
+					 len - starthere, &starthere, gran, window))) {
 		if (!writecount++)
 			msg_cdbg("W");
+		if (writemap)
+			blockmap_set(writemap, start + starthere, lenhere);
 		/* Needs the partial write function signature. */
+		t = metrics_time_us();
 		ret = flash->chip->write(flash, newcontents + starthere,
 				   start + starthere, lenhere);
-		if (ret)
+		metrics_add_phase(METRICS_WRITE, t, lenhere);
+		if (ret) {
+			shadow_invalidate(flash, start + starthere, lenhere);
 			return ret;
+		}
+		/* Write was successful. Adjust curcontents. */
+		memcpy(curcontents + starthere, newcontents + starthere, lenhere);
+		shadow_update(flash, start + starthere, lenhere, newcontents + starthere);
+		/* Large blocks (up to the whole chip) make progress with each write. */
+		progress_add(FLASHROM_PROGRESS_WRITE, lenhere);
+		written += lenhere;
 		starthere += lenhere;
 		skip = 0;
 	}
+	progress_add(FLASHROM_PROGRESS_WRITE, len - written);
 	if (skip)
 		msg_cdbg("S");
 	else
@@ -1398,45 +2176,6 @@ static int erase_and_write_block_helper(struct flashctx *flash,
 	return ret;
 }
 
-static int walk_eraseregions(struct flashctx *flash, int erasefunction,
-			     int (*do_something) (struct flashctx *flash,
-						  unsigned int addr,
-						  unsigned int len,
-						  uint8_t *param1,
-						  uint8_t *param2,
-						  int (*erasefn) (
-							struct flashctx *flash,
-							unsigned int addr,
-							unsigned int len)),
-			     void *param1, void *param2)
-{
-	int i, j;
-	unsigned int start = 0;
-	unsigned int len;
-	struct block_eraser eraser = flash->chip->block_erasers[erasefunction];
-
-	for (i = 0; i < NUM_ERASEREGIONS; i++) {
-		/* count==0 for all automatically initialized array
-		 * members so the loop below won't be executed for them.
-		 */
-		len = eraser.eraseblocks[i].size;
-		for (j = 0; j < eraser.eraseblocks[i].count; j++) {
-			/* Print this for every block except the first one. */
-			if (i || j)
-				msg_cdbg(", ");
-			msg_cdbg("0x%06x-0x%06x", start,
-				     start + len - 1);
-			if (do_something(flash, start, len, param1, param2,
-					 eraser.block_erase)) {
-				return 1;
-			}
-			start += len;
-		}
-	}
-	msg_cdbg("\n");
-	return 0;
-}
-
 static int check_block_eraser(const struct flashctx *flash, int k, int log)
 {
 	struct block_eraser eraser = flash->chip->block_erasers[k];
@@ -1462,50 +2201,467 @@ static int check_block_eraser(const struct flashctx *flash, int k, int log)
 	return 0;
 }
 
-int erase_and_write_flash(struct flashctx *flash, uint8_t *oldcontents,
-			  uint8_t *newcontents)
-{
-	int k, ret = 1;
+/* Rough cost estimates used by the erase planner, in microseconds. They are modeled after typical SPI NOR
+ * datasheet values (about 45 ms for a 4 kB sector, 250 ms for a 64 kB block) and only need to be good
+ * enough to compare the alternatives for a given area with each other.
+ */
+#define PLAN_ERASE_COST_BASE	30000ULL	/* Fixed cost of issuing any erase command. */
+#define PLAN_ERASE_COST_PER_KB	3500ULL		/* Additional cost per kB of erased area. */
+#define PLAN_WRITE_COST_PER_B	3ULL		/* Cost of (re)writing one byte. */
+/* Cost of erasing a block whose old contents are not known. Sums are saturated at this value. */
+#define PLAN_COST_INFEASIBLE	(1ULL << 60)
+
+/* One block of an erase function as seen by the erase planner. */
+struct plan_block {
+	unsigned int start;
+	unsigned int len;
+	/* Estimated cost of getting this block from curcontents to newcontents, 0 if not yet computed. */
+	unsigned long long cost;
+	/* Erase function whose (smaller) blocks are used instead of this one, or -1 to use this block. */
+	int sub;
+};
+
+/* Summary of the differences between curcontents and newcontents within one unit of the erase planner. */
+struct diff_unit {
+	uint32_t diff;		/* Number of bytes which differ. */
+	uint32_t nonerased;	/* Number of bytes in newcontents which are not 0xff. */
+	bool erase;		/* Whether the unit needs to be erased before it can be written. */
+};
+
+struct erase_plan {
+	/* The planned area of the chip. Only erase blocks which lie completely inside of it are used. */
+	unsigned int base;
+	unsigned int size;
+	/* One entry per erase function, blocks[k] is NULL if erase function k can not be used. */
+	struct plan_block *blocks[NUM_ERASEFUNCTIONS];
+	unsigned int count[NUM_ERASEFUNCTIONS];
+	/* Contents of the planned area, i.e. curcontents[0] belongs to chip offset base. */
 	uint8_t *curcontents;
-	unsigned long size = flash->chip->total_size * 1024;
-	unsigned int usable_erasefunctions = count_usable_erasers(flash);
+	uint8_t *newcontents;
+	enum write_granularity gran;
+	/* Every block of every usable erase function consists of whole units, NULL if there is no such
+	 * unit which is also a multiple of the write granularity. */
+	struct diff_unit *units;
+	unsigned int unit_size;
+	/* Parts of curcontents which were read from the chip, NULL if all of it was read. */
+	const struct blockmap *readmap;
+	/* Erase units which were erased or written, NULL if they are not verified afterwards. */
+	struct blockmap *writemap;
+	/* Erase function and block which failed, their contents on the chip are unknown. */
+	int failed;
+	unsigned int failed_start;
+	unsigned int failed_len;
+};
 
-	msg_cinfo("Erasing and writing flash chip... ");
-	curcontents = malloc(size);
-	if (!curcontents) {
-		msg_gerr("Out of memory!\n");
-		exit(1);
+static void free_erase_plan(struct erase_plan *plan)
+{
+	int k;
+
+	for (k = 0; k < NUM_ERASEFUNCTIONS; k++) {
+		free(plan->blocks[k]);
+		plan->blocks[k] = NULL;
+		plan->count[k] = 0;
 	}
-	/* Copy oldcontents to curcontents to avoid clobbering oldcontents. */
-	memcpy(curcontents, oldcontents, size);
+	free(plan->units);
+	plan->units = NULL;
+}
+
+/* Summarize the differences between the old and new contents per unit in a single pass, so that the cost
+ * of every candidate block can be computed from the units instead of rescanning the buffers for each
+ * erase function.
+ */
+static void init_diff_units(struct erase_plan *plan)
+{
+	unsigned int size = plan->size;
+	unsigned int unit = 0, stride = get_gran_stride(plan->gran);
+	unsigned int i, n, start;
+	int k;
+
+	for (k = 0; k < NUM_ERASEFUNCTIONS; k++)
+		for (i = 0; i < plan->count[k]; i++)
+			unit = gcd(unit, plan->blocks[k][i].len);
+	plan->units = NULL;
+	plan->unit_size = unit;
+	if (!unit || !stride || unit % stride)
+		return;
+	n = size / unit;
+	plan->units = malloc(n * sizeof(struct diff_unit));
+	if (!plan->units)
+		return;
+	for (i = 0; i < n; i++) {
+		uint8_t *have = plan->curcontents + i * unit;
+		uint8_t *want = plan->newcontents + i * unit;
+		start = first_difference(have, want, unit);
+		if (start == unit) {
+			plan->units[i].diff = 0;
+			plan->units[i].erase = false;
+		} else {
+			plan->units[i].diff = count_differences(have + start, want + start, unit - start);
+			plan->units[i].erase = need_erase(have, want, unit, plan->gran);
+		}
+		plan->units[i].nonerased = count_nonerased(want, unit);
+	}
+}
+
+/* Returns 1 if the block at @start with length @len lies inside the planned area. */
+static int in_plan_area(const struct erase_plan *plan, unsigned int start, unsigned int len)
+{
+	return start >= plan->base && start + len <= plan->base + plan->size;
+}
+
+/* Set up the block lists of all erase functions which are usable, not marked in @excluded, and whose blocks
+ * inside the area of @size bytes at @base cover it completely.
+ */
+static int init_erase_plan(const struct flashctx *flash, struct erase_plan *plan, const bool *excluded,
+			   unsigned int base, unsigned int size)
+{
+	int i, j, k;
+	unsigned int n, start, covered;
+
+	plan->base = base;
+	plan->size = size;
+	plan->units = NULL;
+	for (k = 0; k < NUM_ERASEFUNCTIONS; k++) {
+		const struct block_eraser *eraser = &flash->chip->block_erasers[k];
+
+		plan->blocks[k] = NULL;
+		plan->count[k] = 0;
+		if (excluded[k] || check_block_eraser(flash, k, 0))
+			continue;
+		n = 0;
+		covered = 0;
+		start = 0;
+		for (i = 0; i < NUM_ERASEREGIONS; i++) {
+			for (j = 0; j < eraser->eraseblocks[i].count; j++) {
+				if (in_plan_area(plan, start, eraser->eraseblocks[i].size)) {
+					covered += eraser->eraseblocks[i].size;
+					n++;
+				}
+				start += eraser->eraseblocks[i].size;
+			}
+		}
+		if (covered != size)
+			continue;
+		plan->blocks[k] = calloc(n, sizeof(struct plan_block));
+		if (!plan->blocks[k]) {
+			msg_gerr("Out of memory!\n");
+			free_erase_plan(plan);
+			return 1;
+		}
+		plan->count[k] = n;
+		n = 0;
+		start = 0;
+		for (i = 0; i < NUM_ERASEREGIONS; i++) {
+			for (j = 0; j < eraser->eraseblocks[i].count; j++) {
+				if (in_plan_area(plan, start, eraser->eraseblocks[i].size)) {
+					plan->blocks[k][n].start = start;
+					plan->blocks[k][n].len = eraser->eraseblocks[i].size;
+					plan->blocks[k][n].sub = -1;
+					n++;
+				}
+				start += eraser->eraseblocks[i].size;
+			}
+		}
+	}
+	return 0;
+}
+
+/* Returns the index of the block of erase function k which starts at @addr, or -1 if there is none. */
+static int find_plan_block(const struct erase_plan *plan, int k, unsigned int addr)
+{
+	int lo = 0, hi = (int)plan->count[k] - 1;
+
+	while (lo <= hi) {
+		int mid = (lo + hi) / 2;
+		if (plan->blocks[k][mid].start == addr)
+			return mid;
+		if (plan->blocks[k][mid].start < addr)
+			lo = mid + 1;
+		else
+			hi = mid - 1;
+	}
+	return -1;
+}
+
+/* Estimated cost of handling a block with a single erase (if needed) followed by the necessary writes. */
+static unsigned long long plan_own_cost(const struct erase_plan *plan, unsigned int start, unsigned int len)
+{
+	uint8_t *have = plan->curcontents + start - plan->base;
+	uint8_t *want = plan->newcontents + start - plan->base;
+	unsigned long long diff = 0, nonerased = 0;
+	bool erase = false;
+	unsigned int i;
+
+	if (plan->units) {
+		for (i = (start - plan->base) / plan->unit_size;
+		     i < (start - plan->base + len) / plan->unit_size; i++) {
+			diff += plan->units[i].diff;
+			nonerased += plan->units[i].nonerased;
+			erase |= plan->units[i].erase;
+		}
+	} else {
+		diff = count_differences(have, want, len);
+		if (diff) {
+			nonerased = count_nonerased(want, len);
+			erase = need_erase(have, want, len, plan->gran);
+		}
+	}
+	if (erase && plan->readmap && !blockmap_test(plan->readmap, start, len))
+		return PLAN_COST_INFEASIBLE;
+	if (erase)
+		return PLAN_ERASE_COST_BASE + PLAN_ERASE_COST_PER_KB * len / 1024 +
+		       PLAN_WRITE_COST_PER_B * nonerased;
+	return PLAN_WRITE_COST_PER_B * diff;
+}
+
+/* Compute the cheapest way to handle block @idx of erase function @k: Either as a whole, or tiled by the
+ * smaller blocks of another erase function whose block boundaries coincide with the ones of this block.
+ * The result is memoized in the block, costs are offset by one to tell "free" from "not computed yet".
+ */
+static unsigned long long plan_block_cost(struct erase_plan *plan, int k, int idx)
+{
+	struct plan_block *block = &plan->blocks[k][idx];
+	unsigned long long best, sum;
+	int j, first, last, t;
+
+	if (block->cost)
+		return block->cost - 1;
+
+	best = plan_own_cost(plan, block->start, block->len);
+	block->sub = -1;
+	for (j = 0; j < NUM_ERASEFUNCTIONS && best; j++) {
+		if (j == k || !plan->blocks[j])
+			continue;
+		first = find_plan_block(plan, j, block->start);
+		if (first < 0)
+			continue;
+		/* The blocks of erase function j have to end exactly where this block ends. */
+		for (last = first; last < plan->count[j]; last++)
+			if (plan->blocks[j][last].start + plan->blocks[j][last].len >= block->start + block->len)
+				break;
+		if (last == plan->count[j] ||
+		    plan->blocks[j][last].start + plan->blocks[j][last].len != block->start + block->len)
+			continue;
+		/* A single block of the same size is not a refinement. */
+		if (last == first)
+			continue;
+		sum = 0;
+		for (t = first; t <= last && sum < best; t++)
+			sum += plan_block_cost(plan, j, t);
+		if (sum < best) {
+			best = sum;
+			block->sub = j;
+		}
+	}
+	block->cost = best + 1;
+	return best;
+}
+
+/* Returns the erase function whose blocks should be used on the top level, or -1 if none is usable without
+ * erasing data which was not read.
+ */
+static int plan_erase(struct erase_plan *plan)
+{
+	unsigned long long best = 0, sum;
+	int k, t, top = -1;
 
 	for (k = 0; k < NUM_ERASEFUNCTIONS; k++) {
-		if (k != 0)
-			msg_cdbg("Looking for another erase function.\n");
-		if (!usable_erasefunctions) {
+		if (!plan->blocks[k])
+			continue;
+		sum = 0;
+		for (t = 0; t < plan->count[k] && sum < PLAN_COST_INFEASIBLE; t++)
+			sum += plan_block_cost(plan, k, t);
+		if (sum >= PLAN_COST_INFEASIBLE)
+			msg_cdbg2("Erase function %i: would erase data which was not read.\n", k);
+		else
+			msg_cdbg2("Erase function %i: estimated cost %llu ms.\n", k, sum / 1000);
+		if (top < 0 || sum < best) {
+			best = sum;
+			top = k;
+		}
+	}
+	if (best >= PLAN_COST_INFEASIBLE)
+		return -1;
+	return top;
+}
+
+/* Executes the plan for block @idx of erase function @k. On failure, the erase function which was in use
+ * and the failing block are recorded in @plan.
+ */
+static int execute_plan_block(struct flashctx *flash, struct erase_plan *plan, int k, int idx)
+{
+	struct plan_block *block = &plan->blocks[k][idx];
+	int j = block->sub, t;
+
+	if (j >= 0) {
+		t = find_plan_block(plan, j, block->start);
+		for (; t < plan->count[j] && plan->blocks[j][t].start < block->start + block->len; t++)
+			if (execute_plan_block(flash, plan, j, t))
+				return 1;
+		return 0;
+	}
+	msg_cdbg("%s0x%06x-0x%06x", block->start ? ", " : "", block->start, block->start + block->len - 1);
+	if (erase_and_write_block_helper(flash, block->start, block->len,
+					 plan->curcontents + block->start - plan->base,
+					 plan->newcontents + block->start - plan->base,
+					 flash->chip->block_erasers[k].block_erase, plan->writemap)) {
+		plan->failed = k;
+		plan->failed_start = block->start;
+		plan->failed_len = block->len;
+		return 1;
+	}
+	return 0;
+}
+
+/* Wait until the chip can be read back reliably after a write. The write functions of SPI chips and of the
+ * chips with TIMING_ZERO already poll for the completion of every program operation, so there is nothing left
+ * to wait for.
+ */
+static int settle_after_write(struct flashctx *flash)
+{
+	int timing = flash->chip->settle_timing;
+
+	if (timing == 0)
+		timing = (flash->chip->bustype == BUS_SPI) ? TIMING_ZERO : 1000 * 1000;
+	if (timing > 0)
+		programmer_delay(timing);
+	return 0;
+}
+
+/* Read the parts of the chip marked in @readmap into @buf, or the whole chip if @readmap is NULL. */
+static int read_flash_by_map(struct flashctx *flash, uint8_t *buf, const struct blockmap *readmap)
+{
+	unsigned int size = flash->chip->total_size * 1024, start = 0, len;
+	int ret = 0;
+
+	progress_start(FLASHROM_PROGRESS_READ, readmap ? blockmap_bytes(readmap) : size);
+	if (!readmap)
+		ret = read_flash_shadowed(flash, buf, 0, size);
+	while (readmap && !ret && (len = blockmap_next(readmap, &start))) {
+		ret = read_flash_shadowed(flash, buf + start, start, len);
+		start += len;
+	}
+	progress_end();
+	return ret;
+}
+
+/* Verify the parts of the chip marked in @readmap against @buf, or the whole chip if @readmap is NULL. */
+static int verify_flash_by_map(struct flashctx *flash, uint8_t *buf, const struct blockmap *readmap)
+{
+	unsigned int size = flash->chip->total_size * 1024, start = 0, len;
+	int ret = 0;
+
+	progress_start(FLASHROM_PROGRESS_VERIFY, readmap ? blockmap_bytes(readmap) : size);
+	if (!readmap)
+		ret = verify_range(flash, buf, 0, size);
+	while (readmap && !ret && (len = blockmap_next(readmap, &start))) {
+		ret = verify_range(flash, buf + start, start, len);
+		start += len;
+	}
+	progress_end();
+	return ret;
+}
+
+/* Read the old contents of all erase blocks which overlap the included layout regions into @buf and mark
+ * them in @readmap. The rest of the chip is left alone, the erase planner will not touch it.
+ */
+static int read_flash_for_layout(struct flashctx *flash, uint8_t *buf, struct blockmap *readmap)
+{
+	unsigned int start = 0;
+	chipoff_t region_start, region_end;
+
+	if (blockmap_init(flash, readmap))
+		return 1;
+	while (!get_next_included_region(start, &region_start, &region_end)) {
+		region_start = max(region_start, start);
+		blockmap_set(readmap, region_start, region_end - region_start + 1);
+		start = region_end + 1;
+		/* Catch overflow. */
+		if (!start)
+			break;
+	}
+	return read_flash_by_map(flash, buf, readmap);
+}
+
+/* Walks the runs of units in the @len bytes at @start of @plan's area. Units which were not read (not marked
+ * in @readmap) get their newcontents set to their curcontents, so no plan touches them. With @reread, the
+ * marked ones are read again into curcontents.
+ */
+static int sync_unread_units(struct flashctx *flash, struct erase_plan *plan, const struct blockmap *readmap,
+			     unsigned int start, unsigned int len, int reread)
+{
+	unsigned int pos = start, end = start + len, next, runlen;
+
+	if (!readmap)
+		return reread ? read_flash_shadowed(flash, plan->curcontents + start - plan->base, start, len) : 0;
+	while (pos < end) {
+		next = pos;
+		runlen = blockmap_next(readmap, &next);
+		if (!runlen || next > end)
+			next = end;
+		memcpy(plan->newcontents + pos - plan->base, plan->curcontents + pos - plan->base, next - pos);
+		if (next == end)
+			break;
+		runlen = min(runlen, end - next);
+		if (reread && read_flash_shadowed(flash, plan->curcontents + next - plan->base, next, runlen))
+			return 1;
+		pos = next + runlen;
+	}
+	return 0;
+}
+
+/* Erase and write the area of @size bytes at chip offset @base. @curcontents holds its current contents
+ * and is kept up to date, @newcontents the requested ones. Erase functions marked in @excluded are not used,
+ * failing ones are added to it. If @writemap is not NULL, all erase units which were erased or written (even
+ * partially or unsuccessfully) are marked in it, and the caller has to verify them afterwards.
+ */
+static int erase_and_write_area(struct flashctx *flash, unsigned int base, unsigned int size,
+				uint8_t *curcontents, uint8_t *newcontents, bool *excluded,
+				const struct blockmap *readmap, struct blockmap *writemap)
+{
+	int k, top, ret = 1;
+	struct erase_plan plan;
+
+	/* Grow the scratch buffer once for the blank checks of the largest blocks. */
+	get_scratch_buffer(flash, get_largest_eraseblock(flash, size));
+	progress_start(FLASHROM_PROGRESS_WRITE, size);
+	while (1) {
+		if (init_erase_plan(flash, &plan, excluded, base, size))
+			break;
+		plan.curcontents = curcontents;
+		plan.newcontents = newcontents;
+		plan.gran = flash->chip->gran;
+		plan.readmap = readmap;
+		plan.writemap = writemap;
+		/* What is outside of the units read is unknown, so it is left alone. */
+		sync_unread_units(flash, &plan, readmap, base, size, 0);
+		init_diff_units(&plan);
+		top = plan_erase(&plan);
+		if (top < 0) {
 			msg_cdbg("No usable erase functions left.\n");
+			free_erase_plan(&plan);
+			ret = 1;
 			break;
 		}
-		msg_cdbg("Trying erase function %i... ", k);
-		if (check_block_eraser(flash, k, 1))
-			continue;
-		usable_erasefunctions--;
-		ret = walk_eraseregions(flash, k, &erase_and_write_block_helper,
-					curcontents, newcontents);
+		msg_cdbg("Using erase function %i and its refinements... ", top);
+		ret = 0;
+		for (k = 0; k < plan.count[top] && !ret; k++)
+			ret = execute_plan_block(flash, &plan, top, k);
+		if (!ret)
+			msg_cdbg("\n");
+		free_erase_plan(&plan);
 		/* If everything is OK, don't try another erase function. */
 		if (!ret)
 			break;
-		/* Write/erase failed, so try to find out what the current chip
-		 * contents are. If no usable erase functions remain, we can
-		 * skip this: the next iteration will break immediately anyway.
+		/* Write/erase failed, so plan again without the failing erase
+		 * function. curcontents is kept up to date for every completed
+		 * block, only the contents of the failing block are unknown.
 		 */
-		if (!usable_erasefunctions)
-			continue;
-		/* Reading the whole chip may take a while, inform the user even
-		 * in non-verbose mode.
-		 */
-		msg_cinfo("Reading current flash chip contents... ");
-		if (flash->chip->read(flash, curcontents, 0, size)) {
+		excluded[plan.failed] = true;
+		msg_cdbg("Erase function %i failed. Looking for another erase function.\n", plan.failed);
+		msg_cinfo("Reading current flash chip contents at 0x%06x-0x%06x... ", plan.failed_start,
+			  plan.failed_start + plan.failed_len - 1);
+		if (sync_unread_units(flash, &plan, readmap, plan.failed_start, plan.failed_len, 1)) {
 			/* Now we are truly screwed. Read failed as well. */
 			msg_cerr("Can't read anymore! Aborting.\n");
 			/* We have no idea about the flash chip contents, so
@@ -1515,6 +2671,65 @@ int erase_and_write_flash(struct flashctx *flash, uint8_t *oldcontents,
 		}
 		msg_cinfo("done. ");
 	}
+	progress_end();
+	return ret;
+}
+
+/* Erases and writes the area of @len bytes at @start, which has to be covered by whole erase blocks.
+ * @curcontents and @newcontents hold the current and the requested contents of the area, @excluded the erase
+ * functions known not to work. With @verify_it, everything erased or written is verified afterwards.
+ */
+int write_area_verified(struct flashctx *flash, unsigned int start, unsigned int len, uint8_t *curcontents,
+			uint8_t *newcontents, bool *excluded, int verify_it)
+{
+	struct blockmap writemap = { 0 };
+	unsigned int vstart, vlen;
+	int settled = 0, ret = 1;
+
+	if (verify_it && blockmap_init(flash, &writemap))
+		return 1;
+	if (erase_and_write_area(flash, start, len, curcontents, newcontents, excluded, NULL,
+				 writemap.map ? &writemap : NULL)) {
+		msg_cerr("FAILED!\n");
+		goto out;
+	}
+	/* Verify what was erased or written. */
+	vstart = start;
+	while (writemap.map && (vlen = blockmap_next(&writemap, &vstart)) && vstart < start + len) {
+		vlen = min(vlen, start + len - vstart);
+		if ((!settled++ && settle_after_write(flash)) ||
+		    verify_range(flash, newcontents + vstart - start, vstart, vlen))
+			goto out;
+		vstart += vlen;
+	}
+	ret = 0;
+out:
+	blockmap_free(&writemap);
+	return ret;
+}
+
+/* If @writemap is not NULL, all erase units which were erased or written (even partially or unsuccessfully)
+ * are marked in it, and the caller has to verify them afterwards.
+ */
+int erase_and_write_flash(struct flashctx *flash, uint8_t *oldcontents,
+			  uint8_t *newcontents, const struct blockmap *readmap,
+			  struct blockmap *writemap)
+{
+	int ret;
+	uint8_t *curcontents;
+	unsigned long size = flash->chip->total_size * 1024;
+	bool excluded[NUM_ERASEFUNCTIONS] = { false };
+
+	msg_cinfo("Erasing and writing flash chip... ");
+	curcontents = malloc(size);
+	if (!curcontents) {
+		msg_gerr("Out of memory!\n");
+		exit(1);
+	}
+	/* Copy oldcontents to curcontents to avoid clobbering oldcontents. */
+	memcpy(curcontents, oldcontents, size);
+
+	ret = erase_and_write_area(flash, 0, size, curcontents, newcontents, excluded, readmap, writemap);
 	/* Free the scratchpad. */
 	free(curcontents);
 
@@ -1704,6 +2919,7 @@ void print_banner(void)
 int selfcheck(void)
 {
 	const struct flashchip *chip;
+	unsigned int chipcount = 0;
 	int i;
 	int ret = 0;
 
@@ -1766,9 +2982,16 @@ int selfcheck(void)
 		msg_gerr("Flashchips table miscompilation!\n");
 		ret = 1;
 	}
-	for (chip = flashchips; chip && chip->name; chip++)
-		if (selfcheck_eraseblocks(chip))
-			ret = 1;
+	/* The erase block definitions in flashchips[] are validated at build time by util/flashchips_tool,
+	 * only the generated indices have to match the table this binary was linked with.
+	 */
+	for (chip = flashchips; chip->name; chip++)
+		chipcount++;
+	if (chipcount != flashchips_name_index_size ||
+	    flashchips_class_start[flashchips_probe_classes] != chipcount) {
+		msg_gerr("Flashchips index does not match the flashchips table!\n");
+		ret = 1;
+	}
 
 #if CONFIG_INTERNAL == 1
 	if (chipset_enables == NULL) {
@@ -1910,18 +3133,120 @@ int chip_safety_check(const struct flashctx *flash, int force, int read_it, int
 	return 0;
 }
 
+/* Write the image in @filename window by window: Each window is read from the image file and the chip,
+ * merged according to the layout, erased and written, and verified before the next one is started. Memory
+ * use is bounded by a small multiple of the window size instead of the chip size.
+ */
+static int stream_write_flash(struct flashctx *flash, const char *filename, unsigned int window,
+			      int verify_it)
+{
+#ifdef __LIBPAYLOAD__
+	msg_gerr("Error: No file I/O support in libpayload\n");
+	return 1;
+#else
+	unsigned int size = flash->chip->total_size * 1024;
+	unsigned int align = get_largest_eraseblock(flash, size - 1);
+	unsigned int start, len;
+	bool excluded[NUM_ERASEFUNCTIONS] = { false };
+	chipoff_t region_start, region_end;
+	uint8_t *curcontents, *newcontents;
+	struct stat image_stat;
+	FILE *image;
+	int ret = 1;
+
+	/* Every window has to be covered by whole erase blocks. */
+	if (!align)
+		align = size;
+	window = min(window, size);
+	window = (window + align - 1) / align * align;
+
+	if ((image = fopen(filename, "rb")) == NULL) {
+		msg_gerr("Error: opening file \"%s\" failed: %s\n", filename, strerror(errno));
+		return 1;
+	}
+	if (fstat(fileno(image), &image_stat) != 0) {
+		msg_gerr("Error: getting metadata of file \"%s\" failed: %s\n", filename, strerror(errno));
+		fclose(image);
+		return 1;
+	}
+	if (image_stat.st_size != size) {
+		msg_gerr("Error: Image size (%jd B) doesn't match the flash chip's size (%u B)!\n",
+			 (intmax_t)image_stat.st_size, size);
+		fclose(image);
+		return 1;
+	}
+	curcontents = malloc(window);
+	newcontents = malloc(window);
+	if (!curcontents || !newcontents) {
+		msg_gerr("Out of memory!\n");
+		exit(1);
+	}
+	msg_cinfo("Erasing, writing and verifying flash chip in windows of %u kB... ", window / 1024);
+	progress_start(FLASHROM_PROGRESS_WRITE, size);
+	for (start = 0; start < size; start += len) {
+		len = min(window, size - start);
+		/* Windows without any included region stay untouched. */
+		if (layout_has_included_regions() &&
+		    (get_next_included_region(start, &region_start, &region_end) ||
+		     region_start >= start + len)) {
+			progress_add(FLASHROM_PROGRESS_WRITE, len);
+			continue;
+		}
+		msg_cdbg("\nWindow 0x%06x-0x%06x: ", start, start + len - 1);
+		if (fseek(image, start, SEEK_SET) || fread(newcontents, 1, len, image) != len) {
+			msg_gerr("Error: Failed to read file \"%s\" at offset 0x%06x.\n", filename, start);
+			goto out;
+		}
+		if (read_flash_shadowed(flash, curcontents, start, len)) {
+			msg_cerr("Reading 0x%06x-0x%06x FAILED!\n", start, start + len - 1);
+			goto out;
+		}
+		build_new_image_window(start, len, curcontents, newcontents);
+		/* With --verify-all, the whole window is verified instead of what was erased or written. */
+		if (write_area_verified(flash, start, len, curcontents, newcontents, excluded,
+					verify_it && !verify_all) ||
+		    (verify_it && verify_all && (settle_after_write(flash) ||
+						 verify_range(flash, newcontents, start, len)))) {
+			emergency_help_message();
+			goto out;
+		}
+	}
+	progress_end();
+	if (all_skipped)
+		msg_cinfo("\nWarning: Chip content is identical to the requested image.\n");
+	msg_cinfo("Erase/write done.\n");
+	if (verify_it)
+		msg_cinfo("Verifying flash... VERIFIED.\n");
+	ret = 0;
+out:
+	/* The progress is finished above on success. */
+	if (ret)
+		progress_end();
+	free(curcontents);
+	free(newcontents);
+	fclose(image);
+	return ret;
+#endif
+}
+
 /* This function signature is horrible. We need to design a better interface,
  * but right now it allows us to split off the CLI code.
  * Besides that, the function itself is a textbook example of abysmal code flow.
+ *
+ * Unlike doit(), this leaves the programmer initialized so that further operations can follow.
  */
-int doit(struct flashctx *flash, int force, const char *filename, int read_it,
-	 int write_it, int erase_it, int verify_it)
+int doit_noshutdown(struct flashctx *flash, int force, const char *filename, int read_it,
+		    int write_it, int erase_it, int verify_it)
 {
 	uint8_t *oldcontents;
 	uint8_t *newcontents;
+	struct blockmap readmap = { 0 };
+	struct blockmap writemap = { 0 };
 	int ret = 0;
 	unsigned long size = flash->chip->total_size * 1024;
 
+	all_skipped = true;
+
 	if (chip_safety_check(flash, force, read_it, write_it, erase_it, verify_it)) {
 		msg_cerr("Aborting.\n");
 		ret = 1;
@@ -1945,6 +3270,20 @@ int doit(struct flashctx *flash, int force, const char *filename, int read_it,
 		goto out_nofree;
 	}
 
+	if (write_it && stream_size) {
+#if CONFIG_INTERNAL == 1
+		/* The image is never held completely in memory, so it can't be checked against the board. */
+		if (programmer == PROGRAMMER_INTERNAL && !force_boardmismatch) {
+			msg_perr("Aborting, the image can't be checked against the board when streaming. You can "
+				 "override this with -p internal:boardmismatch=force.\n");
+			ret = 1;
+			goto out_nofree;
+		}
+#endif
+		ret = stream_write_flash(flash, filename, stream_size, verify_it);
+		goto out_nofree;
+	}
+
 	oldcontents = malloc(size);
 	if (!oldcontents) {
 		msg_gerr("Out of memory!\n");
@@ -1972,7 +3311,7 @@ int doit(struct flashctx *flash, int force, const char *filename, int read_it,
 		 * so if the user wanted erase and reboots afterwards, the user
 		 * knows very well that booting won't work.
 		 */
-		if (erase_and_write_flash(flash, oldcontents, newcontents)) {
+		if (erase_and_write_flash(flash, oldcontents, newcontents, NULL, NULL)) {
 			emergency_help_message();
 			ret = 1;
 		}
@@ -1999,14 +3338,23 @@ int doit(struct flashctx *flash, int force, const char *filename, int read_it,
 #endif
 	}
 
-	/* Read the whole chip to be able to check whether regions need to be
+	/* Read the chip to be able to check whether regions need to be
 	 * erased and to give better diagnostics in case write fails.
-	 * The alternative would be to read only the regions which are to be
-	 * preserved, but in that case we might perform unneeded erase which
-	 * takes time as well.
+	 * If only some regions are to be written, reading the erase blocks
+	 * which overlap them is enough: Nothing else will be touched.
+	 * Writes may take what is known from the shadow copy, a verify
+	 * operation has to look at the chip itself.
 	 */
 	msg_cinfo("Reading old flash chip contents... ");
-	if (flash->chip->read(flash, oldcontents, 0, size)) {
+	if (write_it && layout_has_included_regions()) {
+		ret = read_flash_for_layout(flash, oldcontents, &readmap);
+	} else {
+		progress_start(FLASHROM_PROGRESS_READ, size);
+		ret = write_it ? read_flash_shadowed(flash, oldcontents, 0, size) :
+		      read_flash(flash, oldcontents, 0, size);
+		progress_end();
+	}
+	if (ret) {
 		ret = 1;
 		msg_cinfo("FAILED.\n");
 		goto out;
@@ -2019,10 +3367,16 @@ int doit(struct flashctx *flash, int force, const char *filename, int read_it,
 	// ////////////////////////////////////////////////////////////
 
 	if (write_it) {
-		if (erase_and_write_flash(flash, oldcontents, newcontents)) {
+		if (verify_it && blockmap_init(flash, &writemap)) {
+			ret = 1;
+			goto out;
+		}
+		if (erase_and_write_flash(flash, oldcontents, newcontents, readmap.map ? &readmap : NULL,
+					  writemap.map ? &writemap : NULL)) {
 			msg_cerr("Uh oh. Erase/write failed. Checking if "
 				 "anything changed.\n");
-			if (!flash->chip->read(flash, newcontents, 0, size)) {
+			/* Unread parts of oldcontents match newcontents, see build_new_image(). */
+			if (!read_flash_by_map(flash, newcontents, readmap.map ? &readmap : NULL)) {
 				if (!memcmp(oldcontents, newcontents, size)) {
 					msg_cinfo("Good. It seems nothing was changed.\n");
 					nonfatal_help_message();
@@ -2041,9 +3395,13 @@ int doit(struct flashctx *flash, int force, const char *filename, int read_it,
 		msg_cinfo("Verifying flash... ");
 
 		if (write_it) {
-			/* Work around chips which need some time to calm down. */
-			programmer_delay(1000*1000);
-			ret = verify_range(flash, newcontents, 0, size);
+			/* Unless told otherwise, verify only what was actually erased or written. */
+			if (settle_after_write(flash))
+				ret = 1;
+			else if (verify_all)
+				ret = verify_flash_by_map(flash, newcontents, readmap.map ? &readmap : NULL);
+			else
+				ret = verify_flash_by_map(flash, newcontents, &writemap);
 			/* If we tried to write, and verification now fails, we
 			 * might have an emergency situation.
 			 */
@@ -2057,9 +3415,20 @@ int doit(struct flashctx *flash, int force, const char *filename, int read_it,
 	}
 
 out:
+	blockmap_free(&readmap);
+	blockmap_free(&writemap);
 	free(oldcontents);
 	free(newcontents);
 out_nofree:
+	free_scratch_buffer(flash);
+	return ret;
+}
+
+int doit(struct flashctx *flash, int force, const char *filename, int read_it,
+	 int write_it, int erase_it, int verify_it)
+{
+	int ret = doit_noshutdown(flash, force, filename, read_it, write_it, erase_it, verify_it);
+
 	programmer_shutdown();
 	return ret;
 }
@@ -23,6 +23,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "flash.h"
 
 #define MAX_REFLASH_TRIES 0x10
@@ -124,29 +125,23 @@ static void start_program_jedec_common(struct flashctx *flash,
 	chip_writeb(flash, 0xA0, bios + (0x5555 & mask));
 }
 
-static int probe_jedec_common(struct flashctx *flash, unsigned int mask)
+/* Raw result of the JEDEC ID sequence, cached across flashchips[] entries. */
+struct jedec_id_response {
+	uint32_t largeid1;
+	uint32_t largeid2;
+	uint32_t flashcontent1;
+	uint32_t flashcontent2;
+	uint8_t id1;
+};
+
+static void read_jedec_ids(struct flashctx *flash, unsigned int mask, int probe_timing_enter,
+			   int probe_timing_exit, struct jedec_id_response *resp)
 {
 	chipaddr bios = flash->virtual_memory;
 	const struct flashchip *chip = flash->chip;
 	uint8_t id1, id2;
 	uint32_t largeid1, largeid2;
 	uint32_t flashcontent1, flashcontent2;
-	int probe_timing_enter, probe_timing_exit;
-
-	if (chip->probe_timing > 0)
-		probe_timing_enter = probe_timing_exit = chip->probe_timing;
-	else if (chip->probe_timing == TIMING_ZERO) { /* No delay. */
-		probe_timing_enter = probe_timing_exit = 0;
-	} else if (chip->probe_timing == TIMING_FIXME) { /* == _IGNORED */
-		msg_cdbg("Chip lacks correct probe timing information, "
-			     "using default 10mS/40uS. ");
-		probe_timing_enter = 10000;
-		probe_timing_exit = 40;
-	} else {
-		msg_cerr("Chip has negative value in probe_timing, failing "
-		       "without chip access\n");
-		return 0;
-	}
 
 	/* Earlier probes might have been too fast for the chip to enter ID
 	 * mode completely. Allow the chip to finish this before seeing a
@@ -211,10 +206,6 @@ static int probe_jedec_common(struct flashctx *flash, unsigned int mask)
 	if (probe_timing_exit)
 		programmer_delay(probe_timing_exit);
 
-	msg_cdbg("%s: id1 0x%02x, id2 0x%02x", __func__, largeid1, largeid2);
-	if (!oddparity(id1))
-		msg_cdbg(", id1 parity violation");
-
 	/* Read the product ID location again. We should now see normal flash contents. */
 	flashcontent1 = chip_readb(flash, bios);
 	flashcontent2 = chip_readb(flash, bios + 0x01);
@@ -229,12 +220,71 @@ static int probe_jedec_common(struct flashctx *flash, unsigned int mask)
 		flashcontent2 |= chip_readb(flash, bios + 0x101);
 	}
 
+	resp->largeid1 = largeid1;
+	resp->largeid2 = largeid2;
+	resp->flashcontent1 = flashcontent1;
+	resp->flashcontent2 = flashcontent2;
+	resp->id1 = id1;
+}
+
+static int probe_jedec_common(struct flashctx *flash, unsigned int mask)
+{
+	const struct flashchip *chip = flash->chip;
+	uint32_t largeid1, largeid2;
+	uint32_t flashcontent1, flashcontent2;
+	int probe_timing_enter, probe_timing_exit;
+	struct jedec_id_response resp;
+	/* The sequence depends on the mapped window (i.e. chip size), the address mask, timing and reset type. */
+	struct {
+		uint8_t tag;
+		uint8_t reset;
+		uint16_t mask;
+		uint32_t total_size;
+		int32_t probe_timing;
+	} key;
+	int cached;
+
+	if (chip->probe_timing > 0)
+		probe_timing_enter = probe_timing_exit = chip->probe_timing;
+	else if (chip->probe_timing == TIMING_ZERO) { /* No delay. */
+		probe_timing_enter = probe_timing_exit = 0;
+	} else if (chip->probe_timing == TIMING_FIXME) { /* == _IGNORED */
+		msg_cdbg("Chip lacks correct probe timing information, "
+			     "using default 10mS/40uS. ");
+		probe_timing_enter = 10000;
+		probe_timing_exit = 40;
+	} else {
+		msg_cerr("Chip has negative value in probe_timing, failing "
+		       "without chip access\n");
+		return 0;
+	}
+
+	memset(&key, 0, sizeof(key));
+	key.tag = 0x90;
+	key.reset = chip->feature_bits & FEATURE_RESET_MASK;
+	key.mask = mask;
+	key.total_size = chip->total_size;
+	key.probe_timing = chip->probe_timing;
+	if (!probe_cache_lookup(flash, &key, sizeof(key), &cached, &resp, sizeof(resp))) {
+		read_jedec_ids(flash, mask, probe_timing_enter, probe_timing_exit, &resp);
+		probe_cache_store(flash, &key, sizeof(key), 0, &resp, sizeof(resp));
+	}
+	largeid1 = resp.largeid1;
+	largeid2 = resp.largeid2;
+	flashcontent1 = resp.flashcontent1;
+	flashcontent2 = resp.flashcontent2;
+
+	msg_cdbg("%s: id1 0x%02x, id2 0x%02x", __func__, largeid1, largeid2);
+	if (!oddparity(resp.id1))
+		msg_cdbg(", id1 parity violation");
+
 	if (largeid1 == flashcontent1)
 		msg_cdbg(", id1 is normal flash content");
 	if (largeid2 == flashcontent2)
 		msg_cdbg(", id2 is normal flash content");
 
 	msg_cdbg("\n");
+	probe_report_ids(flash, largeid1, largeid2);
 	if (largeid1 != chip->manufacture_id || largeid2 != chip->model_id)
 		return 0;
 
@@ -364,11 +414,7 @@ int write_jedec_1(struct flashctx *flash, uint8_t *src, unsigned int start,
 	chipaddr dst = flash->virtual_memory + start;
 	unsigned int mask;
 	mask = getaddrmask(flash->chip);
-	uint8_t *readbuf = malloc(len);
-	if (!readbuf) {
-		msg_gerr("Could not allocate memory!\n");
-		exit(1);
-	}
+	uint8_t *readbuf = get_scratch_buffer(flash, len);
 
 	for (i = 0; i < len; i++) {
 		write_byte_program_jedec_noretry(flash, src+i, dst+i, mask);
@@ -380,7 +426,6 @@ retry:
 	if (failed) {
 		msg_gerr("Verification impossible because read failed "
 			 "at 0x%x (len 0x%x)\n", start, len);
-		free(readbuf);
 		return failed;
 	}
 	int inc_tried = 0;
@@ -401,7 +446,6 @@ retry:
 		}
 		failed = 1;
 	}
-	free(readbuf);
 
 	if (failed)
 		msg_cerr(" writing sector at 0x%" PRIxPTR " failed!\n", dst);
@@ -190,7 +190,8 @@ int process_include_args(void)
 	return 0;
 }
 
-void layout_cleanup(void)
+/* Forget the regions included so far, but keep the layout itself. */
+void layout_clear_includes(void)
 {
 	int i;
 	for (i = 0; i < num_include_args; i++) {
@@ -202,6 +203,11 @@ void layout_cleanup(void)
 	for (i = 0; i < num_rom_entries; i++) {
 		rom_entries[i].included = 0;
 	}
+}
+
+void layout_cleanup(void)
+{
+	layout_clear_includes();
 	num_rom_entries = 0;
 }
 
@@ -232,6 +238,26 @@ romentry_t *get_next_included_romentry(unsigned int start)
 	return best_entry;
 }
 
+/* Returns 1 if regions were included with -i, 0 if the whole image is to be used. */
+int layout_has_included_regions(void)
+{
+	return num_include_args != 0;
+}
+
+/* Find the next included region which contains @start or begins after it.
+ * Returns 0 and fills in @region_start and @region_end (inclusive) if there is one, 1 otherwise.
+ */
+int get_next_included_region(unsigned int start, chipoff_t *region_start, chipoff_t *region_end)
+{
+	romentry_t *entry = get_next_included_romentry(start);
+
+	if (!entry)
+		return 1;
+	*region_start = entry->start;
+	*region_end = entry->end;
+	return 0;
+}
+
 /* Validate and - if needed - normalize layout entries. */
 int normalize_romentries(const struct flashctx *flash)
 {
@@ -256,11 +282,14 @@ int normalize_romentries(const struct flashctx *flash)
 	return ret;
 }
 
-int build_new_image(const struct flashctx *flash, uint8_t *oldcontents, uint8_t *newcontents)
+/* Like build_new_image(), but @oldcontents and @newcontents only hold the
+ * @len bytes at chip offset @base.
+ */
+int build_new_image_window(unsigned int base, unsigned int len, uint8_t *oldcontents, uint8_t *newcontents)
 {
-	unsigned int start = 0;
+	unsigned int start = base;
+	unsigned int end = base + len;
 	romentry_t *entry;
-	unsigned int size = flash->chip->total_size * 1024;
 
 	/* If no regions were specified for inclusion, assume
 	 * that the user wants to write the complete new image.
@@ -271,17 +300,17 @@ int build_new_image(const struct flashctx *flash, uint8_t *oldcontents, uint8_t
 	/* Non-included romentries are ignored.
 	 * The union of all included romentries is used from the new image.
 	 */
-	while (start < size) {
+	while (start < end) {
 		entry = get_next_included_romentry(start);
 		/* No more romentries for remaining region? */
-		if (!entry) {
-			memcpy(newcontents + start, oldcontents + start,
-			       size - start);
+		if (!entry || entry->start >= end) {
+			memcpy(newcontents + start - base, oldcontents + start - base,
+			       end - start);
 			break;
 		}
 		/* For non-included region, copy from old content. */
 		if (entry->start > start)
-			memcpy(newcontents + start, oldcontents + start,
+			memcpy(newcontents + start - base, oldcontents + start - base,
 			       entry->start - start);
 		/* Skip to location after current romentry. */
 		start = entry->end + 1;
@@ -291,3 +320,8 @@ int build_new_image(const struct flashctx *flash, uint8_t *oldcontents, uint8_t
 	}
 	return 0;
 }
+
+int build_new_image(const struct flashctx *flash, uint8_t *oldcontents, uint8_t *newcontents)
+{
+	return build_new_image_window(0, flash->chip->total_size * 1024, oldcontents, newcontents);
+}
@@ -0,0 +1,319 @@
+/*
+ * This file is part of the flashrom project.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "flash.h"
+#include "programmer.h"
+#include "libflashrom.h"
+
+/* Operations on ranges work in chunks of this size (rounded up to whole erase blocks for writes), which
+ * bounds memory use and sets the granularity of the progress reports.
+ */
+#define LIBFLASHROM_CHUNK	(64 * 1024)
+
+/* programmer_init() keeps a pointer to the parameters and modifies them. */
+static char *programmer_params = NULL;
+/* Set while a programmer is initialized, only one may be at a time. */
+static int programmer_initialized = 0;
+
+int flashrom_programmer_init(const char *name, const char *params)
+{
+	enum programmer prog;
+
+	if (programmer_initialized) {
+		msg_gerr("A programmer is already initialized, shut it down first.\n");
+		return 1;
+	}
+	for (prog = 0; prog < PROGRAMMER_INVALID; prog++)
+		if (!strcmp(programmer_table[prog].name, name))
+			break;
+	if (prog == PROGRAMMER_INVALID) {
+		msg_perr("Unknown programmer \"%s\".\n", name);
+		return 1;
+	}
+	if (params) {
+		programmer_params = strdup(params);
+		if (!programmer_params) {
+			msg_gerr("Out of memory!\n");
+			return 1;
+		}
+	}
+	myusec_calibrate_delay();
+	if (programmer_init(prog, programmer_params)) {
+		flashrom_programmer_shutdown();
+		return 1;
+	}
+	programmer_initialized = 1;
+	return 0;
+}
+
+int flashrom_programmer_shutdown(void)
+{
+	int ret = programmer_shutdown();
+
+	free(programmer_params);
+	programmer_params = NULL;
+	programmer_initialized = 0;
+	return ret;
+}
+
+int flashrom_flash_probe(struct flashctx **flash, const char *chip_name)
+{
+	struct flashctx flashes[2] = {{0}};
+	int i, j, startchip, chipcount = 0;
+
+	if (chip_name && find_flashchip_name(chip_name) < 0) {
+		msg_cerr("Unknown chip \"%s\".\n", chip_name);
+		return 1;
+	}
+	for (j = 0; j < registered_programmer_count && chipcount < ARRAY_SIZE(flashes); j++) {
+		startchip = 0;
+		while (chipcount < ARRAY_SIZE(flashes)) {
+			startchip = probe_flash_named(&registered_programmers[j], startchip, &flashes[chipcount],
+						      0, chip_name);
+			if (startchip == -1)
+				break;
+			chipcount++;
+			startchip++;
+		}
+	}
+	if (chipcount != 1) {
+		if (chipcount)
+			msg_cerr("Multiple flash chip definitions match the detected chip(s).\n");
+		else
+			msg_cerr("No EEPROM/flash device found.\n");
+		for (i = 0; i < chipcount; i++)
+			free(flashes[i].chip);
+		return 1;
+	}
+
+	*flash = malloc(sizeof(**flash));
+	if (!*flash) {
+		msg_gerr("Out of memory!\n");
+		free(flashes[0].chip);
+		return 1;
+	}
+	**flash = flashes[0];
+	/* Given the existence of read locks, we want to unlock for read, erase and write. */
+	if ((*flash)->chip->unlock)
+		(*flash)->chip->unlock(*flash);
+	return 0;
+}
+
+void flashrom_flash_release(struct flashctx *flash)
+{
+	if (!flash)
+		return;
+	free_scratch_buffer(flash);
+	free_shadow(flash);
+	free(flash->chip);
+	free(flash);
+}
+
+const char *flashrom_flash_name(const struct flashctx *flash)
+{
+	return flash->chip->name;
+}
+
+unsigned int flashrom_flash_size(const struct flashctx *flash)
+{
+	return flash->chip->total_size * 1024;
+}
+
+void flashrom_set_progress_callback(struct flashctx *flash, flashrom_progress_callback *callback,
+				    void *user_data)
+{
+	flash->progress_callback = callback;
+	flash->progress_data = user_data;
+}
+
+static void report_progress(struct flashctx *flash, enum flashrom_progress_stage stage, unsigned int current,
+			    unsigned int total)
+{
+	if (flash->progress_callback)
+		flash->progress_callback(flash, stage, current, total, flash->progress_data);
+}
+
+static int check_range(const struct flashctx *flash, unsigned int start, unsigned int len)
+{
+	unsigned int size = flash->chip->total_size * 1024;
+
+	if (start > size || len > size - start) {
+		msg_gerr("Range 0x%x + 0x%x exceeds the flash chip size 0x%x.\n", start, len, size);
+		return 1;
+	}
+	if (!flash->chip->read) {
+		msg_cerr("flashrom has no read function for this flash chip.\n");
+		return 1;
+	}
+	return 0;
+}
+
+int flashrom_read_range(struct flashctx *flash, unsigned int start, unsigned int len, uint8_t *buf)
+{
+	unsigned int done, chunk;
+
+	if (check_range(flash, start, len))
+		return 1;
+	for (done = 0; done < len; done += chunk) {
+		chunk = min(LIBFLASHROM_CHUNK, len - done);
+		if (read_flash(flash, buf + done, start + done, chunk)) {
+			msg_cerr("Reading 0x%06x-0x%06x failed.\n", start + done, start + done + chunk - 1);
+			return 1;
+		}
+		report_progress(flash, FLASHROM_PROGRESS_READ, done + chunk, len);
+	}
+	return 0;
+}
+
+int flashrom_read_range_cb(struct flashctx *flash, unsigned int start, unsigned int len,
+			   flashrom_read_callback *callback, void *user_data)
+{
+	unsigned int done, chunk;
+	uint8_t *buf;
+	int ret = 1;
+
+	if (check_range(flash, start, len))
+		return 1;
+	if (!len)
+		return 0;
+	/* Not the scratch buffer of @flash: The callback may call back into the library, which uses that. */
+	buf = malloc(min(LIBFLASHROM_CHUNK, len));
+	if (!buf) {
+		msg_gerr("Out of memory!\n");
+		return 1;
+	}
+	for (done = 0; done < len; done += chunk) {
+		chunk = min(LIBFLASHROM_CHUNK, len - done);
+		if (read_flash(flash, buf, start + done, chunk)) {
+			msg_cerr("Reading 0x%06x-0x%06x failed.\n", start + done, start + done + chunk - 1);
+			goto out;
+		}
+		if (callback(buf, done, chunk, user_data))
+			goto out;
+		report_progress(flash, FLASHROM_PROGRESS_READ, done + chunk, len);
+	}
+	ret = 0;
+out:
+	free(buf);
+	return ret;
+}
+
+int flashrom_write_range_cb(struct flashctx *flash, unsigned int start, unsigned int len,
+			    flashrom_fill_callback *callback, void *user_data)
+{
+	unsigned int size = flash->chip->total_size * 1024;
+	unsigned int align = get_largest_eraseblock(flash, size - 1);
+	unsigned int window, wstart, wlen, from, to;
+	bool excluded[NUM_ERASEFUNCTIONS] = { false };
+	uint8_t *curcontents, *newcontents;
+	int ret = 1;
+
+	if (check_range(flash, start, len) || chip_safety_check(flash, 0, 0, 1, 0, 0))
+		return 1;
+	if (!len)
+		return 0;
+
+	/* Every window has to be covered by whole erase blocks. */
+	if (!align)
+		align = size;
+	window = (max(LIBFLASHROM_CHUNK, align) + align - 1) / align * align;
+	curcontents = malloc(window);
+	newcontents = malloc(window);
+	if (!curcontents || !newcontents) {
+		msg_gerr("Out of memory!\n");
+		goto out;
+	}
+
+	for (wstart = start / align * align; wstart < start + len; wstart += wlen) {
+		wlen = min(window, size - wstart);
+		from = max(start, wstart);
+		to = min(start + len, wstart + wlen);
+		if (read_flash(flash, curcontents, wstart, wlen)) {
+			msg_cerr("Reading 0x%06x-0x%06x failed.\n", wstart, wstart + wlen - 1);
+			goto out;
+		}
+		/* Keep the contents of the window outside the requested range. */
+		memcpy(newcontents, curcontents, wlen);
+		if (callback(newcontents + from - wstart, from - start, to - from, user_data))
+			goto out;
+		if (write_area_verified(flash, wstart, wlen, curcontents, newcontents, excluded, 1))
+			goto out;
+		report_progress(flash, FLASHROM_PROGRESS_WRITE, to - start, len);
+	}
+	ret = 0;
+out:
+	free(curcontents);
+	free(newcontents);
+	return ret;
+}
+
+static int fill_from_buffer(uint8_t *buf, unsigned int offset, unsigned int len, void *user_data)
+{
+	memcpy(buf, (const uint8_t *)user_data + offset, len);
+	return 0;
+}
+
+int flashrom_write_range(struct flashctx *flash, unsigned int start, unsigned int len, const uint8_t *buf)
+{
+	return flashrom_write_range_cb(flash, start, len, fill_from_buffer, (void *)buf);
+}
+
+int flashrom_verify_range(struct flashctx *flash, unsigned int start, unsigned int len, const uint8_t *buf)
+{
+	unsigned int done, chunk;
+
+	if (check_range(flash, start, len))
+		return 1;
+	for (done = 0; done < len; done += chunk) {
+		chunk = min(LIBFLASHROM_CHUNK, len - done);
+		/* verify_range() doesn't modify the buffer. */
+		if (verify_range(flash, (uint8_t *)buf + done, start + done, chunk))
+			return 1;
+		report_progress(flash, FLASHROM_PROGRESS_VERIFY, done + chunk, len);
+	}
+	return 0;
+}
+
+int flashrom_erase(struct flashctx *flash)
+{
+	unsigned int size = flash->chip->total_size * 1024;
+	bool excluded[NUM_ERASEFUNCTIONS] = { false };
+	uint8_t *curcontents, *newcontents;
+	int ret = 1;
+
+	if (chip_safety_check(flash, 0, 0, 0, 1, 0))
+		return 1;
+	curcontents = malloc(size);
+	newcontents = malloc(size);
+	if (!curcontents || !newcontents) {
+		msg_gerr("Out of memory!\n");
+		goto out;
+	}
+	/* Assuming all bits are 0 makes every block look like it has to be erased, as doit() does. Every
+	 * erased block is blank checked right away, so there is no need to verify the chip again afterwards.
+	 */
+	memset(curcontents, 0x00, size);
+	memset(newcontents, 0xff, size);
+	ret = write_area_verified(flash, 0, size, curcontents, newcontents, excluded, 0);
+out:
+	free(curcontents);
+	free(newcontents);
+	return ret;
+}
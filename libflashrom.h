@@ -0,0 +1,84 @@
+/*
+ * This file is part of the flashrom project.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/*
+ * Library interface of libflashrom.a.
+ *
+ * All state of a probed chip lives in its struct flashctx, operations work on caller supplied buffers or
+ * callbacks and don't touch the CLI globals (chip_to_probe, the layout). The programmer itself is still
+ * global: There can be only one initialized programmer per process at a time, and calls must not be made
+ * concurrently. Messages are printed through print(), which the application has to provide.
+ *
+ * Unless noted otherwise, functions return 0 on success.
+ */
+
+#ifndef __LIBFLASHROM_H__
+#define __LIBFLASHROM_H__ 1
+
+#include <stdint.h>
+
+struct flashctx;
+
+enum flashrom_progress_stage {
+	FLASHROM_PROGRESS_READ,
+	FLASHROM_PROGRESS_WRITE,
+	FLASHROM_PROGRESS_VERIFY,
+};
+
+/* Called after each chunk of an operation, @current of @total bytes are done. */
+typedef void flashrom_progress_callback(struct flashctx *flash, enum flashrom_progress_stage stage,
+					unsigned int current, unsigned int total, void *user_data);
+
+/* Hands @len bytes read at offset @offset of the requested range to the application. */
+typedef int flashrom_read_callback(const uint8_t *buf, unsigned int offset, unsigned int len,
+				   void *user_data);
+
+/* Asks the application for the @len bytes to be written at offset @offset of the requested range. */
+typedef int flashrom_fill_callback(uint8_t *buf, unsigned int offset, unsigned int len, void *user_data);
+
+/* Initializes the programmer called @name with the parameters @params (may be NULL). Only one programmer can
+ * be initialized at a time, further calls fail until flashrom_programmer_shutdown() was called.
+ */
+int flashrom_programmer_init(const char *name, const char *params);
+int flashrom_programmer_shutdown(void);
+
+/* Probes for a flash chip, optionally only for the one called @chip_name. Exactly one chip has to be found,
+ * it is returned in @flash and must be released with flashrom_flash_release().
+ */
+int flashrom_flash_probe(struct flashctx **flash, const char *chip_name);
+void flashrom_flash_release(struct flashctx *flash);
+const char *flashrom_flash_name(const struct flashctx *flash);
+unsigned int flashrom_flash_size(const struct flashctx *flash);
+void flashrom_set_progress_callback(struct flashctx *flash, flashrom_progress_callback *callback,
+				    void *user_data);
+
+int flashrom_read_range(struct flashctx *flash, unsigned int start, unsigned int len, uint8_t *buf);
+int flashrom_read_range_cb(struct flashctx *flash, unsigned int start, unsigned int len,
+			   flashrom_read_callback *callback, void *user_data);
+/* Writes only change what differs, erasing the blocks around the range as needed while keeping their
+ * contents outside of it. Everything erased or written is verified. Writes and erases are refused where the
+ * command line tool refuses them without --force: if the programmer may not write in its current
+ * configuration, or the operation is known not to work on the chip.
+ */
+int flashrom_write_range(struct flashctx *flash, unsigned int start, unsigned int len, const uint8_t *buf);
+int flashrom_write_range_cb(struct flashctx *flash, unsigned int start, unsigned int len,
+			    flashrom_fill_callback *callback, void *user_data);
+int flashrom_verify_range(struct flashctx *flash, unsigned int start, unsigned int len, const uint8_t *buf);
+int flashrom_erase(struct flashctx *flash);
+
+#endif /* !__LIBFLASHROM_H__ */
@@ -0,0 +1,208 @@
+/*
+ * This file is part of the flashrom project.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/*
+ * Performance metrics of a run: Wall time and bytes per phase, bus transactions per registered programmer
+ * and the time spent in programmer_delay(). They are always collected, which costs a few counter updates per
+ * transaction and two clock reads per phase call, and can be written out as JSON at the end of the run.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/time.h>
+#include "flash.h"
+#include "programmer.h"
+
+static const char *const phase_names[METRICS_PHASES] = {
+	[METRICS_INIT]		= "init",
+	[METRICS_PROBE]		= "probe",
+	[METRICS_READ]		= "read",
+	[METRICS_ERASE]		= "erase",
+	[METRICS_WRITE]		= "write",
+	[METRICS_VERIFY]	= "verify",
+};
+
+static struct {
+	uint64_t start_us;
+	struct {
+		unsigned long calls;
+		uint64_t time_us;
+		uint64_t bytes;
+	} phase[METRICS_PHASES];
+	struct {
+		unsigned long calls;
+		uint64_t requested_us;
+		uint64_t time_us;
+	} delay;
+	struct {
+		enum chipbustype buses;
+		unsigned long spi_commands;
+		unsigned long spi_multicommands;
+		uint64_t spi_bytes;
+		unsigned long parallel_accesses;
+		uint64_t parallel_bytes;
+	} pgm[PROGRAMMERS_MAX];
+} metrics;
+
+uint64_t metrics_time_us(void)
+{
+#if HAVE_CLOCK_GETTIME == 1
+	struct timespec ts;
+
+	if (!clock_gettime(CLOCK_MONOTONIC, &ts))
+		return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+void metrics_start(void)
+{
+	memset(&metrics, 0, sizeof(metrics));
+	metrics.start_us = metrics_time_us();
+}
+
+/* Account one call of @phase which started at @start_us and moved @bytes bytes. */
+void metrics_add_phase(enum metrics_phase phase, uint64_t start_us, unsigned long bytes)
+{
+	metrics.phase[phase].calls++;
+	metrics.phase[phase].time_us += metrics_time_us() - start_us;
+	metrics.phase[phase].bytes += bytes;
+}
+
+void metrics_add_delay(int usecs, uint64_t start_us)
+{
+	metrics.delay.calls++;
+	metrics.delay.requested_us += usecs;
+	metrics.delay.time_us += metrics_time_us() - start_us;
+}
+
+/* Returns the index of the registered programmer @flash is attached to, or -1. */
+static int metrics_pgm_index(const struct flashctx *flash)
+{
+	int i;
+
+	if (!flash->pgm)
+		return -1;
+	i = flash->pgm - registered_programmers;
+	if (i < 0 || i >= PROGRAMMERS_MAX)
+		return -1;
+	metrics.pgm[i].buses = flash->pgm->buses_supported;
+	return i;
+}
+
+void metrics_count_spi(const struct flashctx *flash, int multi, unsigned int bytes)
+{
+	int i = metrics_pgm_index(flash);
+
+	if (i < 0)
+		return;
+	if (multi)
+		metrics.pgm[i].spi_multicommands++;
+	else
+		metrics.pgm[i].spi_commands++;
+	metrics.pgm[i].spi_bytes += bytes;
+}
+
+void metrics_count_parallel(const struct flashctx *flash, unsigned int bytes)
+{
+	int i = metrics_pgm_index(flash);
+
+	if (i < 0)
+		return;
+	metrics.pgm[i].parallel_accesses++;
+	metrics.pgm[i].parallel_bytes += bytes;
+}
+
+/* Writes @str as JSON string, NULL as null. */
+static void write_json_string(FILE *f, const char *str)
+{
+	if (!str) {
+		fprintf(f, "null");
+		return;
+	}
+	fputc('"', f);
+	for (; *str; str++) {
+		if (*str == '"' || *str == '\\')
+			fprintf(f, "\\%c", *str);
+		else if ((unsigned char)*str < 0x20)
+			fprintf(f, "\\u%04x", *str);
+		else
+			fputc(*str, f);
+	}
+	fputc('"', f);
+}
+
+/* Write the metrics collected since metrics_start() to @filename ("-" for stdout). */
+int metrics_write_json(const char *filename, const char *programmer_name, const char *chip_name)
+{
+	FILE *f = stdout;
+	char *buses;
+	int i, first = 1;
+
+	if (strcmp(filename, "-")) {
+		f = fopen(filename, "w");
+		if (!f) {
+			msg_gerr("Error: opening metrics file \"%s\" failed: %s\n", filename, strerror(errno));
+			return 1;
+		}
+	}
+
+	fprintf(f, "{\n\t\"flashrom_version\": ");
+	write_json_string(f, flashrom_version);
+	fprintf(f, ",\n\t\"programmer\": ");
+	write_json_string(f, programmer_name);
+	fprintf(f, ",\n\t\"chip\": ");
+	write_json_string(f, chip_name);
+	fprintf(f, ",\n\t\"total_us\": %llu,\n\t\"phases\": {\n",
+		(unsigned long long)(metrics_time_us() - metrics.start_us));
+	for (i = 0; i < METRICS_PHASES; i++)
+		fprintf(f, "\t\t\"%s\": { \"calls\": %lu, \"time_us\": %llu, \"bytes\": %llu }%s\n",
+			phase_names[i], metrics.phase[i].calls, (unsigned long long)metrics.phase[i].time_us,
+			(unsigned long long)metrics.phase[i].bytes, i < METRICS_PHASES - 1 ? "," : "");
+	fprintf(f, "\t},\n\t\"delay\": { \"calls\": %lu, \"requested_us\": %llu, \"time_us\": %llu },\n",
+		metrics.delay.calls, (unsigned long long)metrics.delay.requested_us,
+		(unsigned long long)metrics.delay.time_us);
+	fprintf(f, "\t\"programmers\": [");
+	for (i = 0; i < PROGRAMMERS_MAX; i++) {
+		if (!metrics.pgm[i].buses)
+			continue;
+		buses = flashbuses_to_text(metrics.pgm[i].buses);
+		fprintf(f, "%s\n\t\t{ \"index\": %i, \"buses\": ", first ? "" : ",", i);
+		write_json_string(f, buses);
+		free(buses);
+		fprintf(f, ", \"spi_commands\": %lu, \"spi_multicommands\": %lu, \"spi_bytes\": %llu, "
+			"\"parallel_accesses\": %lu, \"parallel_bytes\": %llu }",
+			metrics.pgm[i].spi_commands, metrics.pgm[i].spi_multicommands,
+			(unsigned long long)metrics.pgm[i].spi_bytes, metrics.pgm[i].parallel_accesses,
+			(unsigned long long)metrics.pgm[i].parallel_bytes);
+		first = 0;
+	}
+	fprintf(f, "%s]\n}\n", first ? "" : "\n\t");
+
+	if (f != stdout && fclose(f)) {
+		msg_gerr("Error: writing metrics file \"%s\" failed: %s\n", filename, strerror(errno));
+		return 1;
+	}
+	return 0;
+}
@@ -114,8 +114,6 @@ int register_par_programmer(const struct par_programmer *pgm,
 	return register_programmer(&rpgm);
 }
 
-/* The limit of 4 is totally arbitrary. */
-#define PROGRAMMERS_MAX 4
 struct registered_programmer registered_programmers[PROGRAMMERS_MAX];
 int registered_programmer_count = 0;
 
@@ -367,6 +367,7 @@ void rmmio_vall(void *addr);
 int dummy_init(void);
 void *dummy_map(const char *descr, uintptr_t phys_addr, size_t len);
 void dummy_unmap(void *virt_addr, size_t len);
+void dummy_delay(int usecs);
 #endif
 
 /* nic3com.c */
@@ -649,6 +650,8 @@ struct registered_programmer {
 		struct opaque_programmer opaque;
 	};
 };
+/* The limit of 4 is totally arbitrary. */
+#define PROGRAMMERS_MAX 4
 extern struct registered_programmer registered_programmers[];
 extern int registered_programmer_count;
 int register_programmer(struct registered_programmer *pgm);
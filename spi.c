@@ -30,16 +30,29 @@
 #include "programmer.h"
 #include "spi.h"
 
+/* The default implementations of the command and multicommand callbacks forward to each other. Transactions
+ * are only counted in the wrapper of the callback the programmer implements itself, so each is counted once.
+ */
 int spi_send_command(struct flashctx *flash, unsigned int writecnt,
 		     unsigned int readcnt, const unsigned char *writearr,
 		     unsigned char *readarr)
 {
+	if (flash->pgm->spi.command != default_spi_send_command)
+		metrics_count_spi(flash, 0, writecnt + readcnt);
 	return flash->pgm->spi.command(flash, writecnt, readcnt, writearr,
 				       readarr);
 }
 
 int spi_send_multicommand(struct flashctx *flash, struct spi_command *cmds)
 {
+	struct spi_command *cmd;
+	unsigned int bytes = 0;
+
+	if (flash->pgm->spi.multicommand != default_spi_send_multicommand) {
+		for (cmd = cmds; cmd->writecnt || cmd->readcnt; cmd++)
+			bytes += cmd->writecnt + cmd->readcnt;
+		metrics_count_spi(flash, 1, bytes);
+	}
 	return flash->pgm->spi.multicommand(flash, cmds);
 }
 
@@ -29,13 +29,20 @@
 #include "programmer.h"
 #include "spi.h"
 
+/* The ID commands below are sent for many flashchips[] entries during probing, their responses are cached
+ * (see probe_cache_lookup()) so that each one goes over the wire only once per session.
+ */
 static int spi_rdid(struct flashctx *flash, unsigned char *readarr, int bytes)
 {
 	static const unsigned char cmd[JEDEC_RDID_OUTSIZE] = { JEDEC_RDID };
+	const unsigned char key[] = { JEDEC_RDID, bytes };
 	int ret;
 	int i;
 
-	ret = spi_send_command(flash, sizeof(cmd), bytes, cmd, readarr);
+	if (!probe_cache_lookup(flash, key, sizeof(key), &ret, readarr, bytes)) {
+		ret = spi_send_command(flash, sizeof(cmd), bytes, cmd, readarr);
+		probe_cache_store(flash, key, sizeof(key), ret, readarr, bytes);
+	}
 	if (ret)
 		return ret;
 	msg_cspew("RDID returned");
@@ -48,9 +55,12 @@ static int spi_rdid(struct flashctx *flash, unsigned char *readarr, int bytes)
 static int spi_rems(struct flashctx *flash, unsigned char *readarr)
 {
 	unsigned char cmd[JEDEC_REMS_OUTSIZE] = { JEDEC_REMS, 0, 0, 0 };
+	static const unsigned char key[] = { JEDEC_REMS };
 	uint32_t readaddr;
 	int ret;
 
+	if (probe_cache_lookup(flash, key, sizeof(key), &ret, readarr, JEDEC_REMS_INSIZE))
+		goto out;
 	ret = spi_send_command(flash, sizeof(cmd), JEDEC_REMS_INSIZE, cmd,
 			       readarr);
 	if (ret == SPI_INVALID_ADDRESS) {
@@ -62,6 +72,8 @@ static int spi_rems(struct flashctx *flash, unsigned char *readarr)
 		ret = spi_send_command(flash, sizeof(cmd), JEDEC_REMS_INSIZE,
 				       cmd, readarr);
 	}
+	probe_cache_store(flash, key, sizeof(key), ret, readarr, JEDEC_REMS_INSIZE);
+out:
 	if (ret)
 		return ret;
 	msg_cspew("REMS returned 0x%02x 0x%02x. ", readarr[0], readarr[1]);
@@ -71,10 +83,13 @@ static int spi_rems(struct flashctx *flash, unsigned char *readarr)
 static int spi_res(struct flashctx *flash, unsigned char *readarr, int bytes)
 {
 	unsigned char cmd[JEDEC_RES_OUTSIZE] = { JEDEC_RES, 0, 0, 0 };
+	const unsigned char key[] = { JEDEC_RES, bytes };
 	uint32_t readaddr;
 	int ret;
 	int i;
 
+	if (probe_cache_lookup(flash, key, sizeof(key), &ret, readarr, bytes))
+		goto out;
 	ret = spi_send_command(flash, sizeof(cmd), bytes, cmd, readarr);
 	if (ret == SPI_INVALID_ADDRESS) {
 		/* Find the lowest even address allowed for reads. */
@@ -84,6 +99,8 @@ static int spi_res(struct flashctx *flash, unsigned char *readarr, int bytes)
 		cmd[3] = (readaddr >> 0) & 0xff,
 		ret = spi_send_command(flash, sizeof(cmd), bytes, cmd, readarr);
 	}
+	probe_cache_store(flash, key, sizeof(key), ret, readarr, bytes);
+out:
 	if (ret)
 		return ret;
 	msg_cspew("RES returned");
@@ -147,6 +164,7 @@ static int probe_spi_rdid_generic(struct flashctx *flash, int bytes)
 	}
 
 	msg_cdbg("%s: id1 0x%02x, id2 0x%02x\n", __func__, id1, id2);
+	probe_report_ids(flash, id1, id2);
 
 	if (id1 == chip->manufacture_id && id2 == chip->model_id)
 		return 1;
@@ -203,6 +221,7 @@ int probe_spi_rems(struct flashctx *flash)
 	id2 = readarr[1];
 
 	msg_cdbg("%s: id1 0x%x, id2 0x%x\n", __func__, id1, id2);
+	probe_report_ids(flash, id1, id2);
 
 	if (id1 == chip->manufacture_id && id2 == chip->model_id)
 		return 1;
@@ -272,6 +291,7 @@ int probe_spi_res2(struct flashctx *flash)
 	id2 = readarr[1];
 
 	msg_cdbg("%s: id1 0x%x, id2 0x%x\n", __func__, id1, id2);
+	probe_report_ids(flash, id1, id2);
 
 	if (id1 != flash->chip->manufacture_id || id2 != flash->chip->model_id)
 		return 0;
@@ -292,6 +312,7 @@ int probe_spi_res3(struct flashctx *flash)
 	id2 = readarr[2];
 
 	msg_cdbg("%s: id1 0x%x, id2 0x%x\n", __func__, id1, id2);
+	probe_report_ids(flash, id1, id2);
 
 	if (id1 != flash->chip->manufacture_id || id2 != flash->chip->model_id)
 		return 0;
@@ -303,11 +324,17 @@ int probe_spi_res3(struct flashctx *flash)
 int probe_spi_at25f(struct flashctx *flash)
 {
 	static const unsigned char cmd[AT25F_RDID_OUTSIZE] = { AT25F_RDID };
+	static const unsigned char key[] = { AT25F_RDID };
 	unsigned char readarr[AT25F_RDID_INSIZE];
 	uint32_t id1;
 	uint32_t id2;
+	int ret;
 
-	if (spi_send_command(flash, sizeof(cmd), sizeof(readarr), cmd, readarr))
+	if (!probe_cache_lookup(flash, key, sizeof(key), &ret, readarr, sizeof(readarr))) {
+		ret = spi_send_command(flash, sizeof(cmd), sizeof(readarr), cmd, readarr);
+		probe_cache_store(flash, key, sizeof(key), ret, readarr, sizeof(readarr));
+	}
+	if (ret)
 		return 0;
 
 	id1 = readarr[0];
@@ -978,6 +1005,14 @@ int spi_read_chunked(struct flashctx *flash, uint8_t *buf, unsigned int start,
 	return rc;
 }
 
+static int is_all_ff(const uint8_t *buf, unsigned int len)
+{
+	while (len--)
+		if (*buf++ != 0xff)
+			return 0;
+	return 1;
+}
+
 /*
  * Write a part of the flash chip.
  * FIXME: Use the chunk code from Michael Karcher instead.
@@ -1012,6 +1047,11 @@ int spi_write_chunked(struct flashctx *flash, uint8_t *buf, unsigned int start,
 		lenhere = min(start + len, (i + 1) * page_size) - starthere;
 		for (j = 0; j < lenhere; j += chunksize) {
 			towrite = min(chunksize, lenhere - j);
+			/* Programming 0xff can't clear any bit. Such chunks appear where nearby writes were
+			 * coalesced over erased bytes.
+			 */
+			if (is_all_ff(buf + starthere - start + j, towrite))
+				continue;
 			rc = spi_nbyte_program(flash, starthere + j, buf + starthere - start + j, towrite);
 			if (rc)
 				break;
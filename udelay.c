@@ -22,6 +22,7 @@
 #ifndef __LIBPAYLOAD__
 
 #include <unistd.h>
+#include <time.h>
 #include <sys/time.h>
 #include <stdlib.h>
 #include <limits.h>
@@ -30,6 +31,50 @@
 /* loops per microsecond */
 static unsigned long micro = 1;
 
+#if HAVE_CLOCK_GETTIME == 1
+/* Delays are timed with the monotonic clock if it is fine-grained enough, which needs no calibration. */
+static int use_monotonic_clock = 0;
+
+/* nanosleep() tends to overshoot by some tens of microseconds, so the last part of a delay is spent polling
+ * the clock.
+ */
+#define CLOCK_DELAY_SPIN_USECS	100
+
+static int monotonic_clock_usable(void)
+{
+	struct timespec ts;
+
+	if (clock_getres(CLOCK_MONOTONIC, &ts) || ts.tv_sec != 0 || ts.tv_nsec > 1000)
+		return 0;
+	return !clock_gettime(CLOCK_MONOTONIC, &ts);
+}
+
+static void clock_delay(int usecs)
+{
+	struct timespec now, deadline;
+
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	deadline.tv_sec += usecs / 1000000;
+	deadline.tv_nsec += (usecs % 1000000) * 1000L;
+	if (deadline.tv_nsec >= 1000000000L) {
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+
+	if (usecs > CLOCK_DELAY_SPIN_USECS) {
+		struct timespec sleep = {
+			.tv_sec = (usecs - CLOCK_DELAY_SPIN_USECS) / 1000000,
+			.tv_nsec = ((usecs - CLOCK_DELAY_SPIN_USECS) % 1000000) * 1000L,
+		};
+		nanosleep(&sleep, NULL);
+	}
+	do {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+	} while (now.tv_sec < deadline.tv_sec ||
+		 (now.tv_sec == deadline.tv_sec && now.tv_nsec < deadline.tv_nsec));
+}
+#endif
+
 __attribute__ ((noinline)) void myusec_delay(int usecs)
 {
 	unsigned long i;
@@ -90,6 +135,14 @@ void myusec_calibrate_delay(void)
 	unsigned long timeusec, resolution;
 	int i, tries = 0;
 
+#if HAVE_CLOCK_GETTIME == 1
+	if (monotonic_clock_usable()) {
+		msg_pdbg("Using the monotonic clock for delays, no calibration needed.\n");
+		use_monotonic_clock = 1;
+		return;
+	}
+#endif
+
 	msg_pinfo("Calibrating delay loop... ");
 	resolution = measure_os_delay_resolution();
 	if (resolution) {
@@ -183,6 +236,12 @@ void internal_sleep(int usecs)
 /* Precise delay. */
 void internal_delay(int usecs)
 {
+#if HAVE_CLOCK_GETTIME == 1
+	if (use_monotonic_clock) {
+		clock_delay(usecs);
+		return;
+	}
+#endif
 	/* If the delay is >1 s, use internal_sleep because timing does not need to be so precise. */
 	if (usecs > 1000000) {
 		internal_sleep(usecs);
@@ -0,0 +1,110 @@
+#!/bin/sh
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+#
+# Benchmark suite, run by "make bench". It reads, erases, writes (the whole
+# image, an update and single regions of a layout) and verifies synthetic
+# firmware images on the chips emulated by the dummy programmer, then runs the
+# microbenchmarks of flashrom_bench.
+#
+# The emulated chips take their program and erase times and the SPI transport
+# its latency and bandwidth from the profiles below, all on the virtual clock of
+# the dummy programmer. The emulated time only depends on the SPI traffic and is
+# therefore repeatable, while the wall time measures what flashrom itself costs.
+# Each operation reports both as MB/s of the image size along with the SPI
+# transactions it took and the bytes they carried.
+
+EXIT_SUCCESS=0
+EXIT_FAILURE=1
+
+# The binaries to test, by default the ones built in the top level directory.
+if [ -z "$FLASHROM" ] ; then
+	FLASHROM="./flashrom"
+fi
+if [ -z "$FLASHROM_BENCH" ] ; then
+	FLASHROM_BENCH="./util/bench/flashrom_bench"
+fi
+
+TRANSPORT="spi_latency=20,spi_bandwidth=2000000,spi_max_read=4096,spi_max_write=256"
+
+# emulated chip, chip name for -c, size in bytes, timing
+CHIPS="MX25L6436:MX25L6406E/MX25L6436E:8388608:time_program=700,time_erase_4k=45000,time_erase_32k=150000,time_erase_64k=300000,time_erase_chip=20000000
+SST25VF032B:SST25VF032B:4194304:time_program=10,time_erase_4k=18000,time_erase_32k=25000,time_erase_64k=25000,time_erase_chip=50000"
+
+TMPDIR=$(mktemp -d -t flashrom_bench.XXXXXXXXXX)
+if [ "$?" != "0" ] ; then
+	echo "Could not create temporary directory"
+	exit $EXIT_FAILURE
+fi
+trap 'rm -rf "$TMPDIR"' EXIT
+
+# Prints one line of results from the metrics and the log of the last run.
+# $1: operation, $2: bytes the MB/s refer to
+report() {
+	EMULATED=$(sed -n 's/^Emulated time: \([0-9]*\) us.*/\1/p' "$TMPDIR/log")
+	awk -v op="$1" -v bytes="$2" -v emulated="${EMULATED:-0}" '
+		/"total_us"/ { gsub(/[^0-9]/, "", $2); wall = $2 }
+		/"spi_commands"/ {
+			for (i = 1; i < NF; i++) {
+				v = $(i + 1); gsub(/[^0-9]/, "", v)
+				if ($i == "\"spi_commands\":" || $i == "\"spi_multicommands\":") transactions += v
+				if ($i == "\"spi_bytes\":") spibytes += v
+			}
+		}
+		function rate(us) { return us ? bytes / 1048576 * 1000000 / us : 0 }
+		END {
+			printf("%-16s %10.2f %10.2f %12.0f %12d %10d\n", op, rate(wall), rate(emulated),
+			       emulated / 1000, transactions, spibytes / 1024)
+		}' "$TMPDIR/metrics.json"
+}
+
+# Runs flashrom with the arguments given and reports the result.
+# $1: operation, remaining arguments: flashrom arguments after the programmer
+run() {
+	OP="$1"
+	shift
+	"$FLASHROM" -p "dummy:emulate=$EMU,image=$TMPDIR/chip.bin,$TIMING,$TRANSPORT" -c "$CHIP" \
+		--metrics "$TMPDIR/metrics.json" "$@" > "$TMPDIR/log" 2>&1
+	if [ "$?" != "0" ] ; then
+		cat "$TMPDIR/log"
+		echo "$OP failed on $EMU"
+		exit $EXIT_FAILURE
+	fi
+	report "$OP" "$SIZE"
+}
+
+echo "$CHIPS" | while IFS=: read EMU CHIP SIZE TIMING ; do
+	"$FLASHROM_BENCH" image "$TMPDIR/old.bin" "$SIZE" 1 "$TMPDIR/layout.txt" &&
+	"$FLASHROM_BENCH" mutate "$TMPDIR/old.bin" "$TMPDIR/new.bin" 2 || exit $EXIT_FAILURE
+	cp "$TMPDIR/new.bin" "$TMPDIR/chip.bin"
+
+	echo
+	echo "$EMU ($CHIP), $((SIZE / 1024)) kB, $TIMING"
+	printf "%-16s %10s %10s %12s %12s %10s\n" "operation" "wall MB/s" "emul MB/s" "emul ms" \
+		"transactions" "SPI kB"
+	run erase -E
+	run write-full -n -w "$TMPDIR/old.bin"
+	run read -r "$TMPDIR/read.bin"
+	cmp -s "$TMPDIR/old.bin" "$TMPDIR/read.bin" || { echo "read back image differs" ; exit $EXIT_FAILURE ; }
+	run verify -v "$TMPDIR/old.bin"
+	run write-update -n -w "$TMPDIR/new.bin"
+	run write-regions -n -l "$TMPDIR/layout.txt" -i nvram -i code -w "$TMPDIR/old.bin"
+done || exit $EXIT_FAILURE
+
+echo
+"$FLASHROM_BENCH" image "$TMPDIR/old.bin" 8388608 1 "$TMPDIR/layout.txt" &&
+"$FLASHROM_BENCH" mutate "$TMPDIR/old.bin" "$TMPDIR/new.bin" 2 &&
+"$FLASHROM_BENCH" micro "$TMPDIR/old.bin" "$TMPDIR/new.bin" "$TMPDIR/layout.txt" || exit $EXIT_FAILURE
+exit $EXIT_SUCCESS
@@ -0,0 +1,404 @@
+/*
+ * This file is part of the flashrom project.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/*
+ * Helper of the benchmark suite (make bench), linked against libflashrom.a.
+ *
+ *	flashrom_bench image <file> <size> <seed> <layout>
+ * writes a synthetic firmware image of <size> bytes and the layout describing its regions,
+ *	flashrom_bench mutate <in> <out> <seed>
+ * derives an update of it which changes parts of the nvram, code and data regions, and
+ *	flashrom_bench micro <old> <new> <layout>
+ * times need_erase(), get_next_write(), compare_range() and build_new_image() on a pair of such images.
+ * The images only depend on the size and the seed, so the numbers are comparable between runs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "flash.h"
+
+/* Each microbenchmark repeats its work until at least this much time has passed. */
+#define MICRO_MIN_US	200000
+#define BLOCK_SIZE	4096
+#define PAGE_SIZE	256
+
+/* Layout of the synthetic image, the regions are aligned to 64 KiB. */
+#define DESC_END(size)	(4 * 1024)
+#define NVRAM_END(size)	(64 * 1024)
+#define CODE_END(size)	((size) / 2)
+#define DATA_END(size)	((size) / 4 * 3)
+#define FREE_END(size)	((size) - 64 * 1024)
+
+/* Only errors and warnings are shown, everything else would disturb the timing. */
+int print(enum msglevel level, const char *fmt, ...)
+{
+	va_list ap;
+	int ret;
+
+	if (level > MSG_WARN)
+		return 0;
+	va_start(ap, fmt);
+	ret = vfprintf(stderr, fmt, ap);
+	va_end(ap);
+	return ret;
+}
+
+static uint32_t rnd_state;
+
+/* xorshift32, the same sequence on every host. */
+static uint32_t rnd(void)
+{
+	rnd_state ^= rnd_state << 13;
+	rnd_state ^= rnd_state >> 17;
+	rnd_state ^= rnd_state << 5;
+	return rnd_state;
+}
+
+static void rnd_seed(unsigned long seed)
+{
+	rnd_state = seed * 2654435761UL + 1;
+	if (!rnd_state)
+		rnd_state = 1;
+}
+
+/* Compressed code: Random bytes, with the occasional run of zeros from alignment padding. */
+static void fill_code(uint8_t *buf, unsigned int len)
+{
+	unsigned int i, run;
+
+	for (i = 0; i < len; i++)
+		buf[i] = rnd();
+	for (i = 0; i < len / 16384; i++) {
+		run = rnd() % 512;
+		memset(buf + rnd() % (len - run), 0x00, run);
+	}
+}
+
+/* Tables: Small values in fixed size records, separated by runs of zeros and erased space. */
+static void fill_data(uint8_t *buf, unsigned int len)
+{
+	unsigned int i = 0, j, n;
+
+	while (i < len) {
+		n = min(len - i, 64 + rnd() % 4096);
+		switch (rnd() % 4) {
+		case 0:
+			memset(buf + i, 0x00, n);
+			break;
+		case 1:
+			memset(buf + i, 0xff, n);
+			break;
+		default:
+			for (j = 0; j < n; j++)
+				buf[i + j] = (j % 16 < 4) ? rnd() % 64 : 0x00;
+			break;
+		}
+		i += n;
+	}
+}
+
+/* Variable storage: Records at the start, the rest is erased. */
+static void fill_nvram(uint8_t *buf, unsigned int len)
+{
+	unsigned int used = len / 4 + rnd() % (len / 4);
+
+	memset(buf, 0xff, len);
+	fill_data(buf, used);
+}
+
+static int write_file(const char *name, const uint8_t *buf, unsigned int len)
+{
+	FILE *f = fopen(name, "wb");
+
+	if (!f || fwrite(buf, 1, len, f) != len) {
+		fprintf(stderr, "Error: Can't write %s.\n", name);
+		if (f)
+			fclose(f);
+		return 1;
+	}
+	return fclose(f) != 0;
+}
+
+static uint8_t *read_file(const char *name, unsigned int *len)
+{
+	uint8_t *buf;
+	long size;
+	FILE *f = fopen(name, "rb");
+
+	if (!f) {
+		fprintf(stderr, "Error: Can't open %s.\n", name);
+		return NULL;
+	}
+	fseek(f, 0, SEEK_END);
+	size = ftell(f);
+	rewind(f);
+	buf = malloc(size);
+	if (!buf) {
+		fprintf(stderr, "Out of memory!\n");
+		exit(1);
+	}
+	if (size <= 0 || fread(buf, 1, size, f) != (size_t)size) {
+		fprintf(stderr, "Error: Can't read %s.\n", name);
+		free(buf);
+		buf = NULL;
+	}
+	fclose(f);
+	*len = size;
+	return buf;
+}
+
+static int make_image(const char *name, unsigned int size, unsigned long seed, const char *layout)
+{
+	static const char *const header = "$FLASHROM_BENCH$";
+	uint8_t *buf;
+	FILE *f;
+	int ret;
+
+	if (size < 1024 * 1024 || size % (64 * 1024)) {
+		fprintf(stderr, "Error: The image size has to be a multiple of 64 KiB and at least 1 MiB.\n");
+		return 1;
+	}
+	buf = malloc(size);
+	if (!buf) {
+		fprintf(stderr, "Out of memory!\n");
+		exit(1);
+	}
+	rnd_seed(seed);
+	memset(buf, 0xff, size);
+	memcpy(buf, header, strlen(header));
+	fill_data(buf + 256, 1024);
+	fill_nvram(buf + DESC_END(size), NVRAM_END(size) - DESC_END(size));
+	fill_code(buf + NVRAM_END(size), CODE_END(size) - NVRAM_END(size));
+	fill_data(buf + CODE_END(size), DATA_END(size) - CODE_END(size));
+	/* The free space stays erased, the boot block is mostly code. */
+	fill_code(buf + FREE_END(size), 48 * 1024);
+	ret = write_file(name, buf, size);
+	free(buf);
+	if (ret)
+		return 1;
+
+	f = fopen(layout, "w");
+	if (!f) {
+		fprintf(stderr, "Error: Can't write %s.\n", layout);
+		return 1;
+	}
+	fprintf(f, "%08x:%08x desc\n", 0, DESC_END(size) - 1);
+	fprintf(f, "%08x:%08x nvram\n", DESC_END(size), NVRAM_END(size) - 1);
+	fprintf(f, "%08x:%08x code\n", NVRAM_END(size), CODE_END(size) - 1);
+	fprintf(f, "%08x:%08x data\n", CODE_END(size), DATA_END(size) - 1);
+	fprintf(f, "%08x:%08x free\n", DATA_END(size), FREE_END(size) - 1);
+	fprintf(f, "%08x:%08x boot\n", FREE_END(size), size - 1);
+	return fclose(f) != 0;
+}
+
+/* Like a typical update: A few variables, some modules of the code and some tables change. */
+static int mutate_image(const char *in, const char *out, unsigned long seed)
+{
+	unsigned int size, i, start, len;
+	uint8_t *buf;
+	int ret;
+
+	buf = read_file(in, &size);
+	if (!buf)
+		return 1;
+	rnd_seed(seed);
+	fill_nvram(buf + DESC_END(size), NVRAM_END(size) - DESC_END(size));
+	for (i = 0; i < 16; i++) {
+		len = 256 + rnd() % (16 * 1024);
+		start = NVRAM_END(size) + rnd() % (CODE_END(size) - NVRAM_END(size) - len);
+		fill_code(buf + start, len);
+	}
+	for (i = 0; i < 8; i++) {
+		len = 64 + rnd() % 4096;
+		start = CODE_END(size) + rnd() % (DATA_END(size) - CODE_END(size) - len);
+		fill_data(buf + start, len);
+	}
+	ret = write_file(out, buf, size);
+	free(buf);
+	return ret;
+}
+
+/* @count is the number of erases or writes found in one pass, -1 if there is nothing to count. */
+static void report(const char *name, unsigned long iterations, unsigned int bytes, uint64_t us, long count)
+{
+	double mbytes = (double)iterations * bytes / (1024 * 1024);
+
+	printf("%-36s %9.1f MB/s", name, us ? mbytes * 1000000 / us : 0.0);
+	if (count >= 0)
+		printf("  (%li per pass)", count);
+	printf("\n");
+}
+
+static void bench_need_erase(uint8_t *have, uint8_t *want, unsigned int size, enum write_granularity gran,
+			     const char *name)
+{
+	unsigned long iterations = 0, erases = 0;
+	uint64_t start = metrics_time_us(), now;
+	unsigned int i;
+
+	do {
+		erases = 0;
+		for (i = 0; i + BLOCK_SIZE <= size; i += BLOCK_SIZE)
+			erases += need_erase(have + i, want + i, BLOCK_SIZE, gran);
+		iterations++;
+		now = metrics_time_us();
+	} while (now - start < MICRO_MIN_US);
+	report(name, iterations, size, now - start, erases);
+}
+
+/* Walks the image block by block like erase_and_write_block_helper() does. */
+static void bench_get_next_write(uint8_t *have, uint8_t *want, unsigned int size, unsigned int window,
+				 const char *name)
+{
+	unsigned long iterations = 0, writes = 0;
+	uint64_t start = metrics_time_us(), now;
+	unsigned int i, pos, len;
+
+	do {
+		writes = 0;
+		for (i = 0; i + BLOCK_SIZE <= size; i += BLOCK_SIZE) {
+			pos = 0;
+			while ((len = get_next_write(have + i + pos, want + i + pos, BLOCK_SIZE - pos, &pos,
+						     write_gran_1bit, window))) {
+				pos += len;
+				writes++;
+			}
+		}
+		iterations++;
+		now = metrics_time_us();
+	} while (now - start < MICRO_MIN_US);
+	report(name, iterations, size, now - start, writes);
+}
+
+static void bench_compare_range(uint8_t *buf, uint8_t *copy, unsigned int size)
+{
+	unsigned long iterations = 0;
+	uint64_t start = metrics_time_us(), now;
+
+	do {
+		if (compare_range(buf, copy, 0, size))
+			return;
+		iterations++;
+		now = metrics_time_us();
+	} while (now - start < MICRO_MIN_US);
+	report("compare_range", iterations, size, now - start, -1);
+}
+
+static int bench_build_new_image(uint8_t *old, uint8_t *new, unsigned int size, char *layout)
+{
+	static const char *const regions[] = { "nvram", "code", "boot" };
+	struct flashchip chip = { .total_size = size / 1024 };
+	struct flashctx flash = { .chip = &chip };
+	unsigned long iterations = 0;
+	uint64_t start, now;
+	uint8_t *buf;
+	char *name;
+	int i;
+
+	if (read_romlayout(layout))
+		return 1;
+	for (i = 0; i < ARRAY_SIZE(regions); i++) {
+		name = strdup(regions[i]);
+		if (!name) {
+			fprintf(stderr, "Out of memory!\n");
+			exit(1);
+		}
+		if (register_include_arg(name))
+			return 1;
+	}
+	if (process_include_args() || normalize_romentries(&flash))
+		return 1;
+
+	buf = malloc(size);
+	if (!buf) {
+		fprintf(stderr, "Out of memory!\n");
+		exit(1);
+	}
+	start = metrics_time_us();
+	do {
+		/* build_new_image() modifies the new image, so each pass starts from a fresh copy. */
+		memcpy(buf, new, size);
+		build_new_image(&flash, old, buf);
+		iterations++;
+		now = metrics_time_us();
+	} while (now - start < MICRO_MIN_US);
+	report("build_new_image (3 regions)", iterations, size, now - start, -1);
+	free(buf);
+	layout_cleanup();
+	return 0;
+}
+
+static int micro(const char *oldname, const char *newname, char *layout)
+{
+	unsigned int size, newsize;
+	uint8_t *old, *new, *erased, *copy;
+	int ret = 1;
+
+	old = read_file(oldname, &size);
+	new = read_file(newname, &newsize);
+	if (!old || !new)
+		goto out;
+	if (size != newsize) {
+		fprintf(stderr, "Error: The images differ in size.\n");
+		goto out;
+	}
+	erased = malloc(size);
+	copy = malloc(size);
+	if (!erased || !copy) {
+		fprintf(stderr, "Out of memory!\n");
+		exit(1);
+	}
+	memset(erased, 0xff, size);
+	memcpy(copy, new, size);
+
+	printf("Microbenchmarks on %u kB images:\n", size / 1024);
+	bench_need_erase(old, new, size, write_gran_1bit, "need_erase (1 bit)");
+	bench_need_erase(old, new, size, write_gran_256bytes, "need_erase (256 bytes)");
+	bench_get_next_write(erased, new, size, PAGE_SIZE, "get_next_write (erased)");
+	bench_get_next_write(old, new, size, PAGE_SIZE, "get_next_write (update)");
+	bench_get_next_write(old, new, size, 0, "get_next_write (update, no window)");
+	bench_compare_range(new, copy, size);
+	ret = bench_build_new_image(old, new, size, layout);
+	free(erased);
+	free(copy);
+out:
+	free(old);
+	free(new);
+	return ret;
+}
+
+static void usage(const char *name)
+{
+	fprintf(stderr, "Usage: %s image <file> <size> <seed> <layout>\n"
+		"       %s mutate <in> <out> <seed>\n"
+		"       %s micro <old> <new> <layout>\n", name, name, name);
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc == 6 && !strcmp(argv[1], "image"))
+		return make_image(argv[2], strtoul(argv[3], NULL, 0), strtoul(argv[4], NULL, 0), argv[5]);
+	if (argc == 5 && !strcmp(argv[1], "mutate"))
+		return mutate_image(argv[2], argv[3], strtoul(argv[4], NULL, 0));
+	if (argc == 5 && !strcmp(argv[1], "micro"))
+		return micro(argv[2], argv[3], argv[4]);
+	usage(argv[0]);
+	return 1;
+}
@@ -0,0 +1,258 @@
+/*
+ * This file is part of the flashrom project.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/*
+ * Build host tool that works on the flashchips[] table. It is linked against a host build of flashchips.c,
+ * with stubs for all the chip driver functions referenced from the table (see the main Makefile), so none of
+ * the function pointers in here may ever be called.
+ *
+ * "check" validates the table and fails the build if it is broken, "index" generates flashchips_index.c.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "flash.h"
+
+static unsigned int count_flashchips(void)
+{
+	unsigned int n = 0;
+
+	while (flashchips[n].name != NULL)
+		n++;
+	return n;
+}
+
+/* Checks the erase block definitions of @chip, returns the number of errors found. */
+static int check_eraseblocks(const struct flashchip *chip)
+{
+	int i, j, k;
+	int errors = 0;
+
+	for (k = 0; k < NUM_ERASEFUNCTIONS; k++) {
+		unsigned int done = 0;
+		const struct block_eraser *eraser = &chip->block_erasers[k];
+
+		for (i = 0; i < NUM_ERASEREGIONS; i++) {
+			/* Blocks with zero size are bugs in flashchips.c. */
+			if (eraser->eraseblocks[i].count && !eraser->eraseblocks[i].size) {
+				fprintf(stderr, "ERROR: Flash chip %s erase function %i region %i has size 0.\n",
+					chip->name, k, i);
+				errors++;
+			}
+			/* Blocks with zero count are bugs in flashchips.c. */
+			if (!eraser->eraseblocks[i].count && eraser->eraseblocks[i].size) {
+				fprintf(stderr, "ERROR: Flash chip %s erase function %i region %i has count 0.\n",
+					chip->name, k, i);
+				errors++;
+			}
+			done += eraser->eraseblocks[i].count * eraser->eraseblocks[i].size;
+		}
+		/* An empty eraseblock definition with an erase function is strange, but not an error. */
+		if (!done)
+			continue;
+		if (done != chip->total_size * 1024) {
+			fprintf(stderr, "ERROR: Flash chip %s erase function %i region walking resulted in 0x%06x "
+				"bytes total, expected 0x%06x bytes.\n", chip->name, k, done, chip->total_size * 1024);
+			errors++;
+		}
+		if (!eraser->block_erase)
+			continue;
+		/* Check if there are identical erase functions for different layouts. That would imply "magic"
+		 * erase functions. The stubs are distinct functions, so comparing pointers works here as well.
+		 */
+		for (j = k + 1; j < NUM_ERASEFUNCTIONS; j++) {
+			if (eraser->block_erase == chip->block_erasers[j].block_erase) {
+				fprintf(stderr, "ERROR: Flash chip %s erase function %i and %i are identical.\n",
+					chip->name, k, j);
+				errors++;
+			}
+		}
+	}
+	return errors;
+}
+
+/* The table checks that used to run on every flashrom start. */
+static int check_table(void)
+{
+	unsigned int i, n = count_flashchips();
+	int errors = 0;
+
+	if (n == 0 || flashchips[0].vendor == NULL) {
+		fprintf(stderr, "ERROR: Flashchips table miscompilation!\n");
+		return 1;
+	}
+	for (i = 0; i < n; i++)
+		errors += check_eraseblocks(&flashchips[i]);
+	if (errors) {
+		fprintf(stderr, "flashchips.c has %i error(s).\n", errors);
+		return 1;
+	}
+	return 0;
+}
+
+static int compare_names(const void *a, const void *b)
+{
+	const unsigned int i = *(const unsigned int *)a;
+	const unsigned int j = *(const unsigned int *)b;
+	int ret = strcmp(flashchips[i].name, flashchips[j].name);
+
+	/* Several entries can share a name, keep those in table order. */
+	if (ret == 0)
+		ret = (i > j) - (i < j);
+	return ret;
+}
+
+/* Entries with the same probe signature send the same ID sequence when probed, so they form a probe class
+ * whose members only differ in the IDs they expect. The ID commands of SPI chips only depend on the probe
+ * function. For the other buses, everything a probe function may look at except the IDs is compared: the
+ * mapped window (size), address and reset sequences (feature bits) and the probe timing.
+ */
+static int same_probe_signature(const struct flashchip *a, const struct flashchip *b)
+{
+	if (a->probe != b->probe || a->bustype != b->bustype)
+		return 0;
+	if (a->bustype == BUS_SPI)
+		return 1;
+	return a->total_size == b->total_size && a->feature_bits == b->feature_bits &&
+	       a->probe_timing == b->probe_timing;
+}
+
+/* Probe class of every entry. Classes are numbered in the order of their first entry in the table. */
+static unsigned int *probe_class;
+
+static int compare_class_order(const void *a, const void *b)
+{
+	const unsigned int i = *(const unsigned int *)a;
+	const unsigned int j = *(const unsigned int *)b;
+
+	if (probe_class[i] != probe_class[j])
+		return (probe_class[i] > probe_class[j]) - (probe_class[i] < probe_class[j]);
+	return (i > j) - (i < j);
+}
+
+static int compare_class_ids(const void *a, const void *b)
+{
+	const unsigned int i = *(const unsigned int *)a;
+	const unsigned int j = *(const unsigned int *)b;
+	const struct flashchip *x = &flashchips[i], *y = &flashchips[j];
+
+	if (probe_class[i] != probe_class[j])
+		return (probe_class[i] > probe_class[j]) - (probe_class[i] < probe_class[j]);
+	if (x->manufacture_id != y->manufacture_id)
+		return (x->manufacture_id > y->manufacture_id) - (x->manufacture_id < y->manufacture_id);
+	if (x->model_id != y->model_id)
+		return (x->model_id > y->model_id) - (x->model_id < y->model_id);
+	return (i > j) - (i < j);
+}
+
+static void write_array(FILE *f, const char *comment, const char *name, const unsigned int *idx, unsigned int n)
+{
+	unsigned int i;
+
+	fprintf(f, "/* %s */\n", comment);
+	fprintf(f, "const uint16_t %s[] = {\n", name);
+	for (i = 0; i < n; i++)
+		fprintf(f, "\t%u,\t/* %s */\n", idx[i], flashchips[idx[i]].name);
+	fprintf(f, "};\n\n");
+}
+
+static int write_index(const char *filename)
+{
+	unsigned int i, j, n = count_flashchips(), classes = 0;
+	unsigned int *idx;
+	FILE *f;
+
+	if (n > 0xffff) {
+		fprintf(stderr, "flashchips[] has %u entries, too many for the index.\n", n);
+		return 1;
+	}
+	idx = malloc(n * sizeof(*idx));
+	probe_class = malloc(n * sizeof(*probe_class));
+	if (!idx || !probe_class) {
+		fprintf(stderr, "Out of memory!\n");
+		return 1;
+	}
+	for (i = 0; i < n; i++) {
+		for (j = 0; j < i && !same_probe_signature(&flashchips[i], &flashchips[j]); j++)
+			;
+		probe_class[i] = (j < i) ? probe_class[j] : classes++;
+	}
+
+	f = fopen(filename, "w");
+	if (!f) {
+		perror(filename);
+		free(idx);
+		free(probe_class);
+		return 1;
+	}
+	fprintf(f, "/* This file was generated from flashchips.c by util/flashchips_tool. Do not edit. */\n\n");
+	fprintf(f, "#include \"flash.h\"\n\n");
+
+	for (i = 0; i < n; i++)
+		idx[i] = i;
+	qsort(idx, n, sizeof(*idx), compare_names);
+	write_array(f, "Indices into flashchips[], sorted by chip name and then by table order.",
+		    "flashchips_name_index", idx, n);
+	fprintf(f, "const unsigned int flashchips_name_index_size = %u;\n\n", n);
+
+	fprintf(f, "/* Entries which send the same ID sequence when probed form a probe class, see\n"
+		   " * util/flashchips_tool. The class of every flashchips[] entry.\n"
+		   " */\n");
+	fprintf(f, "const uint16_t flashchips_probe_class[] = {\n");
+	for (i = 0; i < n; i++)
+		fprintf(f, "\t%u,\t/* %s */\n", probe_class[i], flashchips[i].name);
+	fprintf(f, "};\n\n");
+	fprintf(f, "const unsigned int flashchips_probe_classes = %u;\n\n", classes);
+
+	for (i = 0; i < n; i++)
+		idx[i] = i;
+	qsort(idx, n, sizeof(*idx), compare_class_order);
+	fprintf(f, "/* Where each probe class starts in flashchips_class_index[] and flashchips_id_index[]. */\n");
+	fprintf(f, "const uint16_t flashchips_class_start[] = {\n");
+	for (i = 0; i < n; i++)
+		if (i == 0 || probe_class[idx[i]] != probe_class[idx[i - 1]])
+			fprintf(f, "\t%u,\n", i);
+	fprintf(f, "\t%u,\n};\n\n", n);
+	write_array(f, "Indices into flashchips[], sorted by probe class and then by table order.",
+		    "flashchips_class_index", idx, n);
+
+	qsort(idx, n, sizeof(*idx), compare_class_ids);
+	write_array(f, "Indices into flashchips[], sorted by probe class, manufacture_id, model_id and then by "
+		    "table order.", "flashchips_id_index", idx, n);
+
+	free(idx);
+	free(probe_class);
+	if (fclose(f)) {
+		perror(filename);
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc == 2 && !strcmp(argv[1], "check"))
+		return check_table();
+	if (argc == 3 && !strcmp(argv[1], "index"))
+		return write_index(argv[2]);
+
+	fprintf(stderr, "Usage: %s check\n"
+			"       %s index <file>\n", argv[0], argv[0]);
+	return 1;
+}
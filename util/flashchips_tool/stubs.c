@@ -0,0 +1,122 @@
+void block_erase_chip_en29lv640b(void) {}
+void block_erase_chip_m29f400bt(void) {}
+void block_erase_en29lv640b(void) {}
+void block_erase_m29f400bt(void) {}
+void erase_block_82802ab(void) {}
+void erase_block_jedec(void) {}
+void erase_chip_28sf040(void) {}
+void erase_chip_block_jedec(void) {}
+void erase_opaque(void) {}
+void erase_sector_28sf040(void) {}
+void erase_sector_49lfxxxc(void) {}
+void erase_sector_jedec(void) {}
+void erase_sector_stm50(void) {}
+void printlock_at49f(void) {}
+void printlock_sst_fwhub(void) {}
+void printlock_w39f010(void) {}
+void printlock_w39l010(void) {}
+void printlock_w39l020(void) {}
+void printlock_w39l040(void) {}
+void printlock_w39v040a(void) {}
+void printlock_w39v040b(void) {}
+void printlock_w39v040c(void) {}
+void printlock_w39v040fa(void) {}
+void printlock_w39v040fb(void) {}
+void printlock_w39v040fc(void) {}
+void printlock_w39v080a(void) {}
+void printlock_w39v080fa(void) {}
+void printlock_w39v080fa_dual(void) {}
+void probe_82802ab(void) {}
+void probe_en29lv640b(void) {}
+void probe_jedec(void) {}
+void probe_m29f400bt(void) {}
+void probe_opaque(void) {}
+void probe_spi_at25f(void) {}
+void probe_spi_at45db(void) {}
+void probe_spi_rdid(void) {}
+void probe_spi_rdid4(void) {}
+void probe_spi_rems(void) {}
+void probe_spi_res1(void) {}
+void probe_spi_res2(void) {}
+void probe_spi_res3(void) {}
+void probe_spi_sfdp(void) {}
+void probe_w29ee011(void) {}
+void read_memmapped(void) {}
+void read_opaque(void) {}
+void spi_aai_write(void) {}
+void spi_block_erase_20(void) {}
+void spi_block_erase_50(void) {}
+void spi_block_erase_52(void) {}
+void spi_block_erase_60(void) {}
+void spi_block_erase_62(void) {}
+void spi_block_erase_81(void) {}
+void spi_block_erase_c7(void) {}
+void spi_block_erase_d7(void) {}
+void spi_block_erase_d8(void) {}
+void spi_block_erase_db(void) {}
+void spi_chip_read(void) {}
+void spi_chip_write_1(void) {}
+void spi_chip_write_256(void) {}
+void spi_disable_blockprotect(void) {}
+void spi_disable_blockprotect_at25f(void) {}
+void spi_disable_blockprotect_at25f512a(void) {}
+void spi_disable_blockprotect_at25f512b(void) {}
+void spi_disable_blockprotect_at25fs010(void) {}
+void spi_disable_blockprotect_at25fs040(void) {}
+void spi_disable_blockprotect_at2x_global_unprotect(void) {}
+void spi_disable_blockprotect_at2x_global_unprotect_sec(void) {}
+void spi_disable_blockprotect_at45db(void) {}
+void spi_disable_blockprotect_bp2_ep_srwd(void) {}
+void spi_disable_blockprotect_bp2_srwd(void) {}
+void spi_disable_blockprotect_bp3_srwd(void) {}
+void spi_disable_blockprotect_bp4_srwd(void) {}
+void spi_disable_blockprotect_n25q(void) {}
+void spi_erase_at45cs_sector(void) {}
+void spi_erase_at45db_block(void) {}
+void spi_erase_at45db_chip(void) {}
+void spi_erase_at45db_page(void) {}
+void spi_erase_at45db_sector(void) {}
+void spi_prettyprint_status_register_amic_a25l032(void) {}
+void spi_prettyprint_status_register_at25df(void) {}
+void spi_prettyprint_status_register_at25df_sec(void) {}
+void spi_prettyprint_status_register_at25f(void) {}
+void spi_prettyprint_status_register_at25f4096(void) {}
+void spi_prettyprint_status_register_at25f512a(void) {}
+void spi_prettyprint_status_register_at25f512b(void) {}
+void spi_prettyprint_status_register_at25fs010(void) {}
+void spi_prettyprint_status_register_at25fs040(void) {}
+void spi_prettyprint_status_register_at26df081a(void) {}
+void spi_prettyprint_status_register_at45db(void) {}
+void spi_prettyprint_status_register_bp2_ep_srwd(void) {}
+void spi_prettyprint_status_register_default_bp1(void) {}
+void spi_prettyprint_status_register_default_bp2(void) {}
+void spi_prettyprint_status_register_default_bp3(void) {}
+void spi_prettyprint_status_register_default_bp4(void) {}
+void spi_prettyprint_status_register_default_welwip(void) {}
+void spi_prettyprint_status_register_en25s_wp(void) {}
+void spi_prettyprint_status_register_n25q(void) {}
+void spi_prettyprint_status_register_plain(void) {}
+void spi_prettyprint_status_register_sst25(void) {}
+void spi_prettyprint_status_register_sst25vf016(void) {}
+void spi_prettyprint_status_register_sst25vf040b(void) {}
+void spi_read_at45db(void) {}
+void spi_read_at45db_e8(void) {}
+void spi_write_at45db(void) {}
+void unlock_28f004s5(void) {}
+void unlock_49fl00x(void) {}
+void unlock_49lfxxxc(void) {}
+void unlock_82802ab(void) {}
+void unlock_lh28f008bjt(void) {}
+void unlock_sst_fwhub(void) {}
+void unlock_stm50_nonuniform(void) {}
+void unlock_stm50_uniform(void) {}
+void unlock_w39v040fb(void) {}
+void unlock_w39v080fa(void) {}
+void unprotect_28sf040(void) {}
+void write_28sf040(void) {}
+void write_82802ab(void) {}
+void write_en29lv640b(void) {}
+void write_jedec(void) {}
+void write_jedec_1(void) {}
+void write_m29f400bt(void) {}
+void write_opaque(void) {}
@@ -0,0 +1,87 @@
+#!/bin/sh
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+#
+# This script checks that the fallback to other erase functions after a
+# failure never touches the chip outside the regions included with -i. It
+# writes two regions of a layout on chips emulated by the dummy programmer with
+# the program commands blacklisted, so every erase function fails in turn, and
+# checks the address of every program and erase command flashrom sends.
+#
+# Region b ends in the middle of a 64 kB block whose start was never read, and
+# region a covers the next 64 kB block, so the larger erase blocks tried later
+# overlap the unread part of the chip.
+
+EXIT_SUCCESS=0
+EXIT_FAILURE=1
+
+# The copy of flashrom to test, by default the one built in the top level
+# directory.
+if [ -z "$FLASHROM" ] ; then
+	FLASHROM="./flashrom"
+fi
+
+TMPDIR=$(mktemp -d -t flashrom_test.XXXXXXXXXX)
+if [ "$?" != "0" ] ; then
+	echo "Could not create temporary directory"
+	exit $EXIT_FAILURE
+fi
+trap 'rm -rf "$TMPDIR"' EXIT
+
+printf "0000ff00:0000ffff b\n00010000:0001ffff a\n" > "$TMPDIR/layout.txt"
+# The regions rounded to whole 4 kB erase units, the only part of the chip
+# flashrom reads and may change.
+LOWEST=$((0x00f000))
+HIGHEST=$((0x01ffff))
+
+# emulated chip, chip name for -c, size in bytes, blacklisted program opcodes
+CHIPS="MX25L6436:MX25L6406E/MX25L6436E:8388608:02
+SST25VF032B:SST25VF032B:4194304:02ad"
+
+echo "$CHIPS" | while IFS=: read EMU CHIP SIZE BLACKLIST ; do
+	# An erased chip, so the new contents could be programmed without erasing.
+	dd if=/dev/zero bs=65536 count=$((SIZE / 65536)) 2>/dev/null | tr '\000' '\377' > "$TMPDIR/chip.bin"
+	dd if=/dev/zero bs=65536 count=$((SIZE / 65536)) 2>/dev/null | tr '\000' '\125' > "$TMPDIR/new.bin"
+
+	"$FLASHROM" -p "dummy:emulate=$EMU,image=$TMPDIR/chip.bin,spi_blacklist=$BLACKLIST" -c "$CHIP" \
+		-l "$TMPDIR/layout.txt" -i a -i b -w "$TMPDIR/new.bin" -VVV > "$TMPDIR/log" 2>&1
+	if [ "$?" = "0" ] ; then
+		echo "$EMU: The write succeeded although programming is blacklisted"
+		exit $EXIT_FAILURE
+	fi
+	if ! grep -q "Erase function [0-9]* failed" "$TMPDIR/log" ; then
+		echo "$EMU: No erase function failed, the fallback was not tested"
+		exit $EXIT_FAILURE
+	fi
+
+	# Program (PP, AAI) and erase (4k, 32k, 64k) commands with their address.
+	grep -o "writing [0-9]* bytes: 0x\(02\|ad\|20\|52\|d8\) 0x[0-9a-f]* 0x[0-9a-f]* 0x[0-9a-f]*" \
+		"$TMPDIR/log" | sed 's/.*: \(0x[0-9a-f]*\) 0x\(..\) 0x\(..\) 0x\(..\)$/\1 \2\3\4/' \
+		> "$TMPDIR/commands"
+	if [ ! -s "$TMPDIR/commands" ] ; then
+		echo "$EMU: No program or erase commands found in the log"
+		exit $EXIT_FAILURE
+	fi
+	while read OPCODE ADDR ; do
+		ADDR=$((0x$ADDR))
+		if [ $ADDR -lt $LOWEST ] || [ $ADDR -gt $HIGHEST ] ; then
+			printf "%s: Command %s at 0x%06x is outside of the included regions\n" "$EMU" "$OPCODE" $ADDR
+			exit $EXIT_FAILURE
+		fi
+	done < "$TMPDIR/commands" || exit $EXIT_FAILURE
+	echo "$EMU: OK"
+done || exit $EXIT_FAILURE
+
+exit $EXIT_SUCCESS